@@ -0,0 +1,124 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/algorithm.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+/**
+ * my:: algorithms against their <algorithm>/<numeric> counterparts
+ * range sizes span from cache resident to the ones taking the parallel path
+ */
+
+namespace {
+  std::vector<int> random_values(std::size_t size) {
+    std::mt19937 engine{42};
+    std::uniform_int_distribution<int> dist{-1000, 1000};
+    std::vector<int> values(size);
+    std::generate(values.begin(), values.end(), [&] { return dist(engine); });
+    return values;
+  }
+
+  const auto is_positive = [](int v) { return v > 0; };
+
+  void BM_StdCountIf(benchmark::State& state) {
+    const auto values = random_values(state.range(0));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(std::count_if(values.begin(), values.end(), is_positive));
+    }
+  }
+
+  void BM_MyCountIf(benchmark::State& state) {
+    const auto values = random_values(state.range(0));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(my::count_if(values.begin(), values.end(), is_positive));
+    }
+  }
+
+  void BM_StdAccumulate(benchmark::State& state) {
+    const auto values = random_values(state.range(0));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(std::accumulate(values.begin(), values.end(), 0ll));
+    }
+  }
+
+  void BM_MyAccumulate(benchmark::State& state) {
+    const auto values = random_values(state.range(0));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(my::accumulate(values.begin(), values.end(), 0ll));
+    }
+  }
+
+  void BM_StdTransform(benchmark::State& state) {
+    const auto values = random_values(state.range(0));
+    std::vector<int> out(values.size());
+    for (auto _ : state) {
+      std::transform(values.begin(), values.end(), out.begin(), [](int v) { return v * 3 + 1; });
+      benchmark::DoNotOptimize(out.data());
+    }
+  }
+
+  void BM_MyTransform(benchmark::State& state) {
+    const auto values = random_values(state.range(0));
+    std::vector<int> out(values.size());
+    for (auto _ : state) {
+      my::transform(values.begin(), values.end(), out.begin(), [](int v) { return v * 3 + 1; });
+      benchmark::DoNotOptimize(out.data());
+    }
+  }
+
+  void BM_StdSort(benchmark::State& state) {
+    const auto values = random_values(state.range(0));
+    for (auto _ : state) {
+      state.PauseTiming();
+      auto copy = values;
+      state.ResumeTiming();
+      std::sort(copy.begin(), copy.end());
+      benchmark::DoNotOptimize(copy.data());
+    }
+  }
+
+  void BM_MySort(benchmark::State& state) {
+    const auto values = random_values(state.range(0));
+    for (auto _ : state) {
+      state.PauseTiming();
+      auto copy = values;
+      state.ResumeTiming();
+      my::sort(copy.begin(), copy.end());
+      benchmark::DoNotOptimize(copy.data());
+    }
+  }
+
+  void BM_StdLowerBound(benchmark::State& state) {
+    auto values = random_values(state.range(0));
+    std::sort(values.begin(), values.end());
+    int probe{-1000};
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(std::lower_bound(values.begin(), values.end(), probe));
+      probe = (probe == 1000) ? -1000 : probe + 1;
+    }
+  }
+
+  void BM_MyLowerBound(benchmark::State& state) {
+    auto values = random_values(state.range(0));
+    std::sort(values.begin(), values.end());
+    int probe{-1000};
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(my::lower_bound(values.begin(), values.end(), probe));
+      probe = (probe == 1000) ? -1000 : probe + 1;
+    }
+  }
+}
+
+BENCHMARK(BM_StdCountIf)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_MyCountIf)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_StdAccumulate)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_MyAccumulate)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_StdTransform)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_MyTransform)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_StdSort)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_MySort)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_StdLowerBound)->Range(1 << 10, 1 << 20);
+BENCHMARK(BM_MyLowerBound)->Range(1 << 10, 1 << 20);
@@ -0,0 +1,101 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/BinarySerialization.h"
+#include "../include/Person.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * Encoding and decoding a million of Person records:
+ * reflection based binary format against operator<< and operator>> over string streams
+ */
+
+namespace {
+  constexpr std::size_t record_count{1'000'000};
+
+  const std::vector<Person>& people() {
+    static const auto people = [] {
+      std::vector<Person> result{};
+      result.reserve(record_count);
+      for (std::size_t i = 0; i < record_count; ++i) {
+        result.emplace_back("first" + std::to_string(i % 1000), "second" + std::to_string(i));
+      }
+      return result;
+    }();
+    return people;
+  }
+
+  std::size_t total_binary_size() {
+    std::size_t size{0};
+    for (const auto& person : people()) {
+      size += my::binary_size(person);
+    }
+    return size;
+  }
+
+  void BM_StreamWrite(benchmark::State& state) {
+    for (auto _ : state) {
+      std::ostringstream os{};
+      for (const auto& person : people()) {
+        os << person;
+      }
+      benchmark::DoNotOptimize(os.str().size());
+    }
+    state.SetItemsProcessed(state.iterations() * record_count);
+  }
+
+  void BM_BinaryWrite(benchmark::State& state) {
+    std::vector<char> buffer(total_binary_size());
+    for (auto _ : state) {
+      my::binary_writer writer{buffer.data(), buffer.size()};
+      for (const auto& person : people()) {
+        writer.write(person);
+      }
+      benchmark::DoNotOptimize(buffer.data());
+    }
+    state.SetItemsProcessed(state.iterations() * record_count);
+  }
+
+  void BM_StreamRead(benchmark::State& state) {
+    std::ostringstream os{};
+    for (const auto& person : people()) {
+      os << person;
+    }
+    const auto text = os.str();
+
+    std::vector<Person> decoded(record_count);
+    for (auto _ : state) {
+      std::istringstream is{text};
+      for (auto& person : decoded) {
+        is >> person;
+      }
+      benchmark::DoNotOptimize(decoded.data());
+    }
+    state.SetItemsProcessed(state.iterations() * record_count);
+  }
+
+  void BM_BinaryRead(benchmark::State& state) {
+    std::vector<char> buffer(total_binary_size());
+    my::binary_writer writer{buffer.data(), buffer.size()};
+    for (const auto& person : people()) {
+      writer.write(person);
+    }
+
+    std::vector<Person> decoded(record_count);
+    for (auto _ : state) {
+      my::binary_reader reader{buffer.data(), buffer.size()};
+      for (auto& person : decoded) {
+        reader.read(person);
+      }
+      benchmark::DoNotOptimize(decoded.data());
+    }
+    state.SetItemsProcessed(state.iterations() * record_count);
+  }
+}
+
+BENCHMARK(BM_StreamWrite)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BinaryWrite)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StreamRead)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_BinaryRead)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,109 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/BloomFilter.h"
+#include "../include/CharPrimeMap.h"
+
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Probe loop of WordContainer::get: the 255 subset keys of 8 letter racks looked up in a map of 50k words,
+ * straight away against after checking the Bloom filter first
+ */
+
+namespace {
+  struct Fixture {
+    Fixture() {
+      std::mt19937 generator{7};
+      std::uniform_int_distribution<int> letter{'a', 'z'};
+      std::uniform_int_distribution<std::size_t> length{2, 8};
+      const my::alphabet_char_prime_map primes{};
+
+      auto key = [&primes](const std::string& str_) {
+        std::uint64_t product{1};
+        for (auto c : str_) {
+          product *= primes.prime(c);
+        }
+        return product;
+      };
+
+      for (int i = 0; i < 50000; ++i) {
+        std::string word(length(generator), ' ');
+        for (auto& c : word) {
+          c = static_cast<char>(letter(generator));
+        }
+        map.emplace(key(word), word);
+      }
+      filter = my::blocked_bloom_filter{map.size()};
+      for (const auto& entry : map) {
+        filter.insert(entry.first);
+      }
+
+      for (int i = 0; i < 1000; ++i) {
+        std::string rack(8, ' ');
+        for (auto& c : rack) {
+          c = static_cast<char>(letter(generator));
+        }
+        for (unsigned mask = 1; mask < 256; ++mask) {
+          std::string subset{};
+          for (unsigned bit = 0; bit < 8; ++bit) {
+            if (mask & (1u << bit)) {
+              subset += rack[bit];
+            }
+          }
+          probes.push_back(key(subset));
+        }
+      }
+    }
+
+    std::unordered_map<std::uint64_t, std::string> map{};
+    my::blocked_bloom_filter filter{};
+    std::vector<std::uint64_t> probes{};
+  };
+
+  const Fixture& fixture() {
+    static const Fixture f{};
+    return f;
+  }
+
+  constexpr std::size_t probes_per_query{255};
+
+  void BM_ProbeMap(benchmark::State& state) {
+    const auto& f = fixture();
+    std::size_t offset{0}, found{0};
+    for (auto _ : state) {
+      for (std::size_t i = offset; i < offset + probes_per_query; ++i) {
+        found += f.map.find(f.probes[i]) != f.map.end();
+      }
+      offset = (offset + probes_per_query) % f.probes.size();
+    }
+    benchmark::DoNotOptimize(found);
+    state.SetItemsProcessed(state.iterations()); // queries
+  }
+
+  void BM_ProbeFilterThenMap(benchmark::State& state) {
+    const auto& f = fixture();
+    std::size_t offset{0}, found{0}, avoided{0};
+    for (auto _ : state) {
+      for (std::size_t i = offset; i < offset + probes_per_query; ++i) {
+        if (!f.filter.may_contain(f.probes[i])) {
+          ++avoided;
+          continue;
+        }
+        found += f.map.find(f.probes[i]) != f.map.end();
+      }
+      offset = (offset + probes_per_query) % f.probes.size();
+    }
+    benchmark::DoNotOptimize(found);
+    state.SetItemsProcessed(state.iterations());
+    const auto probes = static_cast<double>(state.iterations() * probes_per_query);
+    state.counters["probes_avoided"] = static_cast<double>(avoided) / probes;
+    state.counters["misses_avoided"] = static_cast<double>(avoided) / (probes - static_cast<double>(found));
+    state.counters["filter_KB"] = static_cast<double>(f.filter.memory()) / 1024;
+  }
+}
+
+BENCHMARK(BM_ProbeMap);
+BENCHMARK(BM_ProbeFilterThenMap);
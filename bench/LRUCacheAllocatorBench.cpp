@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/LRUCache.h"
+
+#include <memory_resource>
+#include <random>
+#include <vector>
+
+/**
+ * Churn on a full cache, where every insert of a new key evicts one (a node freed, a node allocated):
+ * default allocator against a std::pmr::unsynchronized_pool_resource that recycles the nodes
+ */
+
+namespace {
+  constexpr int cache_size{1 << 16};
+
+  std::vector<int> keys() {
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int> key{0, 4 * cache_size}; // most of them miss, and evict
+    std::vector<int> result(1 << 20);
+    for (auto& k : result) {
+      k = key(generator);
+    }
+    return result;
+  }
+
+  template <typename Cache>
+  void churn(benchmark::State& state, Cache& cache_) {
+    const auto trace = keys();
+    for (int i = 0; i < cache_size; ++i) {
+      cache_.insert(i, i);
+    }
+
+    std::size_t index{0};
+    for (auto _ : state) {
+      const auto key = trace[index];
+      if (cache_.get(key) == cache_.end()) {
+        cache_.insert(key, key);
+      }
+      index = (index + 1) % trace.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  void BM_LRUCacheChurnDefault(benchmark::State& state) {
+    LRUCache<int, int> cache{cache_size};
+    churn(state, cache);
+  }
+
+  void BM_LRUCacheChurnPool(benchmark::State& state) {
+    std::pmr::unsynchronized_pool_resource pool{};
+    PmrLRUCache<int, int> cache{cache_size, &pool};
+    churn(state, cache);
+  }
+}
+
+BENCHMARK(BM_LRUCacheChurnDefault);
+BENCHMARK(BM_LRUCacheChurnPool);
@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/LRUCache.h"
+
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Looking up a batch of keys in a large cache (much larger than the processor caches):
+ * get() in a loop against multiGet(), both with and without a lock around every call
+ */
+
+namespace {
+  constexpr int entry_count{1 << 20};
+
+  LRUCache<int, std::string>& cache() {
+    static LRUCache<int, std::string> cache = [] {
+      LRUCache<int, std::string> result{entry_count};
+      for (int i = 0; i < entry_count; ++i) {
+        result.insert(i, "value " + std::to_string(i));
+      }
+      return result;
+    }();
+    return cache;
+  }
+
+  std::vector<int> batches(std::size_t batch_size_) {
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<int> key{0, 2 * entry_count}; // half of them are missing
+    std::vector<int> keys(batch_size_ * 256);
+    for (auto& k : keys) {
+      k = key(generator);
+    }
+    return keys;
+  }
+
+  std::mutex lock{};
+
+  template <bool Locked>
+  void BM_GetLoop(benchmark::State& state) {
+    const auto batch_size = static_cast<std::size_t>(state.range(0));
+    const auto keys = batches(batch_size);
+    std::vector<LRUCache<int, std::string>::iterator> found(batch_size);
+    std::size_t offset{0};
+    for (auto _ : state) {
+      const auto* batch = keys.data() + offset;
+      for (std::size_t i = 0; i < batch_size; ++i) {
+        if constexpr (Locked) {
+          std::lock_guard<std::mutex> guard{lock};
+          found[i] = cache().get(batch[i]);
+        }
+        else {
+          found[i] = cache().get(batch[i]);
+        }
+      }
+      benchmark::DoNotOptimize(found.data());
+      offset = (offset + batch_size) % keys.size();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * batch_size));
+  }
+
+  template <bool Locked>
+  void BM_MultiGet(benchmark::State& state) {
+    const auto batch_size = static_cast<std::size_t>(state.range(0));
+    const auto keys = batches(batch_size);
+    std::vector<LRUCache<int, std::string>::iterator> found(batch_size);
+    std::size_t offset{0};
+    for (auto _ : state) {
+      const auto* batch = keys.data() + offset;
+      if constexpr (Locked) {
+        std::lock_guard<std::mutex> guard{lock};
+        cache().multiGet(batch, batch + batch_size, found.begin());
+      }
+      else {
+        cache().multiGet(batch, batch + batch_size, found.begin());
+      }
+      benchmark::DoNotOptimize(found.data());
+      offset = (offset + batch_size) % keys.size();
+    }
+    state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * batch_size));
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_GetLoop, false)->Arg(16)->Arg(64)->Arg(200);
+BENCHMARK_TEMPLATE(BM_MultiGet, false)->Arg(16)->Arg(64)->Arg(200);
+BENCHMARK_TEMPLATE(BM_GetLoop, true)->Arg(16)->Arg(64)->Arg(200);
+BENCHMARK_TEMPLATE(BM_MultiGet, true)->Arg(16)->Arg(64)->Arg(200);
@@ -0,0 +1,58 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/LRUCache.h"
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+/**
+ * Latency of insert() into a full cache of MB sized values made of many allocations (which is what makes
+ * destroying them expensive): every insert evicts one, destroying it inline against handing it over
+ * to the background reclaimer
+ */
+
+namespace {
+  using value_t = std::vector<std::string>;
+
+  value_t makeValue(int key_) {
+    return value_t(20000, std::string(48, static_cast<char>('a' + key_ % 26)));
+  }
+
+  void insertLatency(benchmark::State& state, bool background_) {
+    LRUCache<int, value_t> cache{8};
+    if (background_) {
+      cache.reclaimInBackground(8);
+    }
+
+    std::vector<double> latencies{};
+    int key{0};
+    for (auto _ : state) {
+      auto value = makeValue(key);
+
+      const auto start = std::chrono::steady_clock::now();
+      benchmark::DoNotOptimize(cache.insert(key++, std::move(value)));
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+      state.SetIterationTime(elapsed.count());
+      latencies.push_back(elapsed.count() * 1e6);
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+    state.counters["p50_us"] = latencies[latencies.size() / 2];
+    state.counters["p99_us"] = latencies[latencies.size() * 99 / 100];
+    state.counters["max_us"] = latencies.back();
+  }
+
+  void BM_InsertEvictInline(benchmark::State& state) {
+    insertLatency(state, false);
+  }
+
+  void BM_InsertEvictInBackground(benchmark::State& state) {
+    insertLatency(state, true);
+  }
+}
+
+BENCHMARK(BM_InsertEvictInline)->UseManualTime()->Iterations(500)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_InsertEvictInBackground)->UseManualTime()->Iterations(500)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,80 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/Pattern.h"
+
+#include <regex>
+#include <string>
+
+/**
+ * Patterns of RegexUseTest: std::regex (constructed once, or per use as in the tests)
+ * against the patterns compiled at compile time
+ */
+
+namespace {
+  const std::string html_tag{"tag starts now: <h1>the value<h1>: that ended the tags"};
+
+  const std::string& separated() {
+    static const std::string source = [] {
+      std::string result{};
+      for (int i = 0; i < 2000; ++i) {
+        result += "entity" + std::to_string(i) + (i % 2 ? ",  " : " ; ");
+      }
+      return result;
+    }();
+    return source;
+  }
+
+  constexpr my::pattern<> sep_pattern{"[[:s:]]*[,;.:][[:s:]]*"};
+  constexpr my::tag_pattern tag{};
+
+  void BM_RegexConstructAndSearchTag(benchmark::State& state) {
+    for (auto _ : state) {
+      const std::regex pattern{"<(.*)>(.*)<(\\1)>"};
+      std::smatch match;
+      benchmark::DoNotOptimize(std::regex_search(html_tag, match, pattern));
+    }
+  }
+
+  void BM_RegexSearchTag(benchmark::State& state) {
+    const std::regex pattern{"<(.*)>(.*)<(\\1)>"};
+    for (auto _ : state) {
+      std::smatch match;
+      benchmark::DoNotOptimize(std::regex_search(html_tag, match, pattern));
+    }
+  }
+
+  void BM_TagPatternSearch(benchmark::State& state) {
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(tag.search(html_tag));
+    }
+  }
+
+  void BM_RegexSplit(benchmark::State& state) {
+    const std::regex pattern{"[[:s:]]*[,;.:][[:s:]]*"};
+    for (auto _ : state) {
+      std::size_t count{0};
+      for (std::sregex_token_iterator itr{separated().begin(), separated().end(), pattern, -1}, end{}; itr != end; ++itr) {
+        count += itr->length();
+      }
+      benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(state.iterations() * separated().size());
+  }
+
+  void BM_PatternSplit(benchmark::State& state) {
+    for (auto _ : state) {
+      std::size_t count{0};
+      for (auto token : sep_pattern.split(separated())) {
+        count += token.size();
+      }
+      benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(state.iterations() * separated().size());
+  }
+}
+
+BENCHMARK(BM_RegexConstructAndSearchTag);
+BENCHMARK(BM_RegexSearchTag);
+BENCHMARK(BM_TagPatternSearch);
+BENCHMARK(BM_RegexSplit)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_PatternSplit)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,85 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/Person.h"
+#include "../include/RecordFile.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * Loading a file of Person records (size in MB is the benchmark argument):
+ * operator>> over std::ifstream, one record at a time, against read_record_file on 1 and on all hardware threads.
+ * Writing is measured as well: operator<< over std::ofstream against record_file_writer.
+ * For multi-GB files, pass a bigger argument to Arg() below; the file is created in the temp directory
+ */
+
+namespace {
+  const std::string path{(std::filesystem::temp_directory_path() / "RecordFileBench.txt").string()};
+
+  std::size_t record_count(std::size_t megabytes) {
+    return megabytes * (1 << 20) / 24; // roughly 24 bytes per record
+  }
+
+  void ensure_file(std::size_t megabytes) {
+    static std::size_t created{0};
+    if (created != megabytes) {
+      my::record_file_writer<Person> writer{path};
+      for (std::size_t i = 0, count = record_count(megabytes); i < count; ++i) {
+        writer.write(Person{"first" + std::to_string(i % 10000), "second" + std::to_string(i)});
+      }
+      created = megabytes;
+    }
+  }
+
+  void BM_StreamReadFile(benchmark::State& state) {
+    ensure_file(state.range(0));
+    for (auto _ : state) {
+      std::ifstream file{path};
+      std::vector<Person> people{};
+      Person person{};
+      while (file >> person) {
+        people.push_back(person);
+      }
+      benchmark::DoNotOptimize(people.data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * (1 << 20));
+  }
+
+  void BM_RecordFileRead(benchmark::State& state) {
+    ensure_file(state.range(0));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(my::read_record_file<Person>(path, state.range(1)).data());
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0) * (1 << 20));
+  }
+
+  void BM_StreamWriteFile(benchmark::State& state) {
+    const std::vector<Person> people(record_count(state.range(0)), Person{"first1234", "second123456"});
+    for (auto _ : state) {
+      std::ofstream file{path + ".out"};
+      for (const auto& person : people) {
+        file << person << '\n';
+      }
+    }
+    std::remove((path + ".out").c_str());
+    state.SetItemsProcessed(state.iterations() * people.size());
+  }
+
+  void BM_RecordFileWrite(benchmark::State& state) {
+    const std::vector<Person> people(record_count(state.range(0)), Person{"first1234", "second123456"});
+    for (auto _ : state) {
+      my::record_file_writer<Person> writer{path + ".out"};
+      writer.write(people.begin(), people.end());
+    }
+    std::remove((path + ".out").c_str());
+    state.SetItemsProcessed(state.iterations() * people.size());
+  }
+}
+
+BENCHMARK(BM_StreamReadFile)->Arg(64)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RecordFileRead)->Args({64, 1})->Args({64, 0})->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_StreamWriteFile)->Arg(64)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RecordFileWrite)->Arg(64)->Unit(benchmark::kMillisecond);
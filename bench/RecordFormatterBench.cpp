@@ -0,0 +1,64 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/Person.h"
+#include "../include/RecordFormatter.h"
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+/**
+ * Dumping a million records (strings and numbers) through operator<< into std::ostringstream
+ * against record_formatter writing into the same kind of stream
+ */
+
+namespace {
+  constexpr std::size_t record_count{1'000'000};
+
+  struct LogRecord {
+    auto reflect() const { return std::tie(_person, _id, _latency); }
+    Person _person;
+    long _id;
+    double _latency;
+  };
+
+  const std::vector<LogRecord>& records() {
+    static const auto records = [] {
+      std::vector<LogRecord> result{};
+      result.reserve(record_count);
+      for (std::size_t i = 0; i < record_count; ++i) {
+        result.push_back({Person{"first" + std::to_string(i % 1000), "second"}, static_cast<long>(i), i * 0.37});
+      }
+      return result;
+    }();
+    return records;
+  }
+
+  void BM_OstringstreamOperator(benchmark::State& state) {
+    for (auto _ : state) {
+      std::ostringstream os{};
+      for (const auto& record : records()) {
+        os << record;
+      }
+      benchmark::DoNotOptimize(os.str().size());
+    }
+    state.SetItemsProcessed(state.iterations() * record_count);
+  }
+
+  void BM_RecordFormatter(benchmark::State& state) {
+    for (auto _ : state) {
+      std::ostringstream os{};
+      {
+        my::record_formatter formatter{os};
+        for (const auto& record : records()) {
+          formatter.write(record);
+        }
+      }
+      benchmark::DoNotOptimize(os.str().size());
+    }
+    state.SetItemsProcessed(state.iterations() * record_count);
+  }
+}
+
+BENCHMARK(BM_OstringstreamOperator)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RecordFormatter)->Unit(benchmark::kMillisecond);
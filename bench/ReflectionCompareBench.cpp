@@ -0,0 +1,73 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/Person.h"
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/**
+ * Sorting a million of Person records with:
+ *  => reflection derived operator< (a single three-way compare per member)
+ *  => a hand written comparator, doing the same
+ *  => std::tie based operator<, which compares each string twice (a < b, then b < a)
+ */
+
+namespace {
+  constexpr std::size_t record_count{1'000'000};
+
+  struct Name {
+    auto reflect() const { return std::tie(_fName, _sName); }
+    std::string _fName;
+    std::string _sName;
+  };
+
+  const std::vector<Name>& names() {
+    static const auto names = [] {
+      std::mt19937 engine{42};
+      std::uniform_int_distribution<int> dist{0, 5000};
+      std::vector<Name> result(record_count);
+      for (auto& name : result) {
+        name._fName = "first_name_" + std::to_string(dist(engine));
+        name._sName = "second_name_" + std::to_string(dist(engine));
+      }
+      return result;
+    }();
+    return names;
+  }
+
+  template <typename Compare>
+  void sort_benchmark(benchmark::State& state, const Compare& compare) {
+    for (auto _ : state) {
+      state.PauseTiming();
+      auto copy = names();
+      state.ResumeTiming();
+      std::sort(copy.begin(), copy.end(), compare);
+      benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetItemsProcessed(state.iterations() * record_count);
+  }
+
+  void BM_ReflectionSort(benchmark::State& state) {
+    sort_benchmark(state, [](const Name& left, const Name& right) { return left < right; });
+  }
+
+  void BM_HandWrittenSort(benchmark::State& state) {
+    sort_benchmark(state, [](const Name& left, const Name& right) {
+      const auto result = left._fName.compare(right._fName);
+      return (result != 0) ? result < 0 : left._sName.compare(right._sName) < 0;
+    });
+  }
+
+  void BM_TupleSort(benchmark::State& state) {
+    sort_benchmark(state, [](const Name& left, const Name& right) {
+      return std::tie(left._fName, left._sName) < std::tie(right._fName, right._sName);
+    });
+  }
+}
+
+BENCHMARK(BM_ReflectionSort)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_HandWrittenSort)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TupleSort)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,88 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/Person.h"
+
+#include <array>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Reflection based hash of Person against a hand written boost-style combiner
+ * over realistic (heavily repeating) first names and surnames.
+ * Besides the throughput, collisions are reported for the full hash and for
+ * its low 16 bits (what a power-of-two sized table would use as bucket index)
+ */
+
+namespace {
+  struct BoostStyleHash {
+    std::size_t operator()(const Person& person) const {
+      std::size_t seed{0};
+      tuple_for_each(person.reflect(), [&seed](const auto& elem_) {
+        seed ^= std::hash<std::string_view>{}(elem_) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+      });
+      return seed;
+    }
+  };
+
+  const std::vector<Person>& people() {
+    static const auto people = [] {
+      const std::array<const char*, 20> first_names{
+        "James", "Mary", "Robert", "Patricia", "John", "Jennifer", "Michael", "Linda", "David", "Elizabeth",
+        "Anil", "Priya", "Wei", "Mei", "Ahmed", "Fatima", "Carlos", "Maria", "Yuki", "Olga"};
+      const std::array<const char*, 20> surnames{
+        "Smith", "Johnson", "Williams", "Brown", "Jones", "Garcia", "Miller", "Davis", "Rodriguez", "Martinez",
+        "Kumar", "Sharma", "Wang", "Li", "Khan", "Ali", "Silva", "Santos", "Sato", "Ivanova"};
+
+      std::vector<Person> result{};
+      for (int suffix = 0; suffix < 250; ++suffix) {
+        for (auto first : first_names) {
+          for (auto surname : surnames) {
+            result.emplace_back(first, std::string{surname} + (suffix ? std::to_string(suffix) : ""));
+          }
+        }
+      }
+      return result;
+    }();
+    return people;
+  }
+
+  template <typename Hash>
+  void BM_PersonHash(benchmark::State& state) {
+    const Hash hasher{};
+    for (auto _ : state) {
+      for (const auto& person : people()) {
+        benchmark::DoNotOptimize(hasher(person));
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * people().size());
+
+    std::unordered_set<std::size_t> full{}, low_bits{};
+    for (const auto& person : people()) {
+      const auto hash = hasher(person);
+      full.insert(hash);
+      low_bits.insert(hash & 0xffff);
+    }
+    state.counters["collisions"] = static_cast<double>(people().size() - full.size());
+    state.counters["low16_buckets_used"] = static_cast<double>(low_bits.size());
+  }
+
+  template <typename Hash>
+  void BM_PersonUnorderedSetInsert(benchmark::State& state) {
+    for (auto _ : state) {
+      std::unordered_set<Person, Hash> set{};
+      set.reserve(people().size());
+      for (const auto& person : people()) {
+        set.insert(person);
+      }
+      benchmark::DoNotOptimize(set.size());
+    }
+    state.SetItemsProcessed(state.iterations() * people().size());
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_PersonHash, std::hash<Person>);
+BENCHMARK_TEMPLATE(BM_PersonHash, BoostStyleHash);
+BENCHMARK_TEMPLATE(BM_PersonUnorderedSetInsert, std::hash<Person>);
+BENCHMARK_TEMPLATE(BM_PersonUnorderedSetInsert, BoostStyleHash);
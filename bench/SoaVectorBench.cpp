@@ -0,0 +1,126 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/SoaVector.h"
+
+#include <string>
+#include <vector>
+
+/**
+ * Scanning (sum, count and filter) a single arithmetic member of wide records:
+ * std::vector of records (AoS) drags every record through cache,
+ * while soa_vector (SoA) only touches the contiguous column of that member
+ */
+
+namespace {
+  // same members as SoaRecord, plus some payload which a single member scan doesn't need
+  struct Record {
+    long _id{};
+    int _age{};
+    double _salary{};
+    std::string _name{};
+    std::string _city{};
+    double _scores[8]{};
+  };
+
+  struct SoaRecord {
+    auto reflect() const { return std::tie(_id, _age, _salary, _name, _city); }
+    long _id{};
+    int _age{};
+    double _salary{};
+    std::string _name{};
+    std::string _city{};
+  };
+
+  std::vector<Record> make_aos(std::size_t size) {
+    std::vector<Record> records(size);
+    for (std::size_t i = 0; i < size; ++i) {
+      records[i]._id = static_cast<long>(i);
+      records[i]._age = static_cast<int>(i % 80);
+      records[i]._salary = 1000.0 + i % 5000;
+    }
+    return records;
+  }
+
+  my::soa_vector<SoaRecord> make_soa(std::size_t size) {
+    my::soa_vector<SoaRecord> records{};
+    records.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+      records.push_back(SoaRecord{static_cast<long>(i), static_cast<int>(i % 80), 1000.0 + i % 5000, {}, {}});
+    }
+    return records;
+  }
+
+  void BM_AosCountIf(benchmark::State& state) {
+    const auto records = make_aos(state.range(0));
+    for (auto _ : state) {
+      std::size_t count{0};
+      for (const auto& record : records) {
+        count += record._age > 40;
+      }
+      benchmark::DoNotOptimize(count);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  void BM_SoaCountIf(benchmark::State& state) {
+    const auto records = make_soa(state.range(0));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(records.count_if<1>([](int age) { return age > 40; }));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  void BM_AosSum(benchmark::State& state) {
+    const auto records = make_aos(state.range(0));
+    for (auto _ : state) {
+      double sum{0};
+      for (const auto& record : records) {
+        sum += record._salary;
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  void BM_SoaSum(benchmark::State& state) {
+    const auto records = make_soa(state.range(0));
+    for (auto _ : state) {
+      const auto& salaries = records.column<2>();
+      double sum{0};
+      for (auto salary : salaries) {
+        sum += salary;
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  void BM_AosFilter(benchmark::State& state) {
+    const auto records = make_aos(state.range(0));
+    for (auto _ : state) {
+      std::vector<std::size_t> indices{};
+      for (std::size_t i = 0; i < records.size(); ++i) {
+        if (records[i]._age == 30) {
+          indices.push_back(i);
+        }
+      }
+      benchmark::DoNotOptimize(indices.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+
+  void BM_SoaFilter(benchmark::State& state) {
+    const auto records = make_soa(state.range(0));
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(records.filter<1>([](int age) { return age == 30; }).data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+  }
+}
+
+BENCHMARK(BM_AosCountIf)->Range(1 << 12, 1 << 22);
+BENCHMARK(BM_SoaCountIf)->Range(1 << 12, 1 << 22);
+BENCHMARK(BM_AosSum)->Range(1 << 12, 1 << 22);
+BENCHMARK(BM_SoaSum)->Range(1 << 12, 1 << 22);
+BENCHMARK(BM_AosFilter)->Range(1 << 12, 1 << 22);
+BENCHMARK(BM_SoaFilter)->Range(1 << 12, 1 << 22);
@@ -0,0 +1,129 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/Person.h"
+
+#include <array>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+/**
+ * A million people, with heavily repeating first names and surnames (Zipf distributed, some of them
+ * longer than the small string buffer): Person with interned names against the same record holding
+ * std::strings. Reported are the heap bytes per person (including the pool, for Person),
+ * and the cost of comparing people for equality
+ */
+
+namespace {
+  struct PlainPerson {
+    PlainPerson(std::string fName_, std::string sName_) : _fName(std::move(fName_)), _sName(std::move(sName_)) {}
+
+    auto reflect() const { return std::tie(_fName, _sName); }
+
+    std::string _fName;
+    std::string _sName;
+  };
+
+  constexpr std::size_t people_count{1000000};
+
+  // pairs of (first name, surname)
+  const std::vector<std::pair<std::string, std::string>>& names() {
+    static const auto result = [] {
+      const std::array<const char*, 10> first{"James", "Mary", "Christopher", "Anil", "Priya", "Maximilian",
+                                              "Wei", "Fatima", "Alexandria", "Olga"};
+      const std::array<const char*, 10> last{"Smith", "Kumar", "Rodriguez-Garcia", "Wang", "Vanderbilt",
+                                             "Ivanova", "Montgomery-Smythe", "Khan", "Silva", "Sato"};
+
+      std::mt19937 generator{42};
+      auto zipf = [&generator](std::size_t count_) {
+        std::vector<double> weights(count_);
+        for (std::size_t i = 0; i < count_; ++i) {
+          weights[i] = 1.0 / static_cast<double>(i + 1);
+        }
+        return std::discrete_distribution<std::size_t>{weights.begin(), weights.end()};
+      };
+      auto firstName = zipf(1000);
+      auto surname = zipf(20000);
+
+      std::vector<std::pair<std::string, std::string>> pairs(people_count);
+      for (auto& [f, s] : pairs) {
+        const auto fi = firstName(generator);
+        const auto si = surname(generator);
+        f = first[fi % first.size()] + (fi < first.size() ? std::string{} : std::to_string(fi));
+        s = last[si % last.size()] + (si < last.size() ? std::string{} : std::to_string(si));
+      }
+      return pairs;
+    }();
+    return result;
+  }
+
+  std::size_t heapInUse() {
+#if defined(__GLIBC__)
+    const auto info = mallinfo2();
+    return info.uordblks + info.hblkhd; // large blocks (e.g. the vector) are mmapped
+#else
+    return 0;
+#endif
+  }
+
+  template <typename T>
+  std::vector<T> makePeople() {
+    std::vector<T> people{};
+    people.reserve(people_count);
+    for (const auto& [f, s] : names()) {
+      people.emplace_back(f, s);
+    }
+    return people;
+  }
+
+  template <typename T>
+  void BM_PeopleMemory(benchmark::State& state) {
+    // measured on the first run only, as the names stay interned in the global pool for the later ones
+    static const auto bytes = [] {
+      names();
+      const auto before = heapInUse();
+      const auto people = makePeople<T>();
+      return heapInUse() - before;
+    }();
+    state.counters["bytes_per_person"] = static_cast<double>(bytes) / people_count;
+
+    for (auto _ : state) {
+      auto copy = makePeople<T>();
+      benchmark::DoNotOptimize(copy.data());
+    }
+    state.SetItemsProcessed(state.iterations() * people_count);
+  }
+
+  template <typename T>
+  void BM_PeopleEquality(benchmark::State& state) {
+    const auto people = makePeople<T>();
+    const auto others = makePeople<T>(); // equal, but separate objects
+
+    std::mt19937 generator{7};
+    std::uniform_int_distribution<std::size_t> index{0, people_count - 1};
+    std::vector<std::pair<std::size_t, std::size_t>> pairs(1 << 16);
+    for (std::size_t i = 0; i < pairs.size(); ++i) {
+      const auto first = index(generator);
+      pairs[i] = {first, (i % 2) ? first : index(generator)}; // half of them are equal
+    }
+
+    for (auto _ : state) {
+      std::size_t equal{0};
+      for (const auto& [left, right] : pairs) {
+        equal += (people[left] == others[right]);
+      }
+      benchmark::DoNotOptimize(equal);
+    }
+    state.SetItemsProcessed(state.iterations() * pairs.size());
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_PeopleMemory, PlainPerson)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PeopleMemory, Person)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_PeopleEquality, PlainPerson);
+BENCHMARK_TEMPLATE(BM_PeopleEquality, Person);
@@ -0,0 +1,94 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/LRUCache.h"
+#include "../include/TieredLRUCache.h"
+
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * Working set 10x the size of the memory tier, with skewed (Zipf like) accesses:
+ * LRUCache has to recompute every evicted value on its next access,
+ * TieredLRUCache promotes it back from the disk tier instead
+ */
+
+namespace {
+  constexpr std::size_t memory_size{1000};
+  constexpr std::size_t key_count{10 * memory_size};
+
+  // stands in for a value which is expensive to recompute
+  std::string compute(std::size_t key_) {
+    std::uint64_t state{key_};
+    std::string value(128, ' ');
+    for (int round = 0; round < 50; ++round) {
+      for (auto& c : value) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        c = static_cast<char>('a' + (state >> 59));
+      }
+    }
+    return value;
+  }
+
+  const std::vector<std::size_t>& accesses() {
+    static const auto keys = [] {
+      std::mt19937 generator{42};
+      std::vector<double> weights(key_count);
+      for (std::size_t i = 0; i < key_count; ++i) {
+        weights[i] = 1.0 / static_cast<double>(i + 1);
+      }
+      std::discrete_distribution<std::size_t> zipf{weights.begin(), weights.end()};
+      std::vector<std::size_t> result(100000);
+      for (auto& key : result) {
+        key = zipf(generator);
+      }
+      return result;
+    }();
+    return keys;
+  }
+
+  void BM_LRUCacheRecompute(benchmark::State& state) {
+    LRUCache<std::size_t, std::string> cache{memory_size};
+    std::size_t hits{0}, total{0};
+    for (auto _ : state) {
+      for (auto key : accesses()) {
+        auto itr = cache.get(key);
+        if (itr == cache.end()) {
+          itr = cache.insert(key, compute(key));
+        }
+        else {
+          ++hits;
+        }
+        benchmark::DoNotOptimize(itr->second.data());
+      }
+      total += accesses().size();
+    }
+    state.counters["hit_ratio"] = static_cast<double>(hits) / static_cast<double>(total);
+    state.SetItemsProcessed(static_cast<std::int64_t>(total));
+  }
+
+  void BM_TieredLRUCache(benchmark::State& state) {
+    const auto path = (std::filesystem::temp_directory_path() / "TieredLRUCacheBench").string();
+    TieredLRUCache<std::size_t, std::string> cache{memory_size, path, 1 << 20};
+    std::size_t total{0};
+    for (auto _ : state) {
+      for (auto key : accesses()) {
+        auto itr = cache.get(key);
+        if (itr == cache.end()) {
+          itr = cache.insert(key, compute(key));
+        }
+        benchmark::DoNotOptimize(itr->second.data());
+      }
+      total += accesses().size();
+    }
+    const auto stats = cache.stats();
+    state.counters["hit_ratio"] = static_cast<double>(stats.memoryHits + stats.diskHits) / static_cast<double>(total);
+    state.counters["disk_hits"] = static_cast<double>(stats.diskHits) / static_cast<double>(total);
+    state.counters["compactions"] = static_cast<double>(stats.compactions);
+    state.SetItemsProcessed(static_cast<std::int64_t>(total));
+  }
+}
+
+BENCHMARK(BM_LRUCacheRecompute)->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TieredLRUCache)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,50 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/Tokenizer.h"
+
+#include <regex>
+#include <string>
+
+/**
+ * Splitting a log line like text on separators: std::sregex_token_iterator with the
+ * separator pattern of RegexUseTest against my::tokenizer
+ */
+
+namespace {
+  const std::string& source() {
+    static const std::string source = [] {
+      std::string result{};
+      for (int i = 0; i < 10000; ++i) {
+        result += "some_entity_" + std::to_string(i) + ",  value " + std::to_string(i * 7) + "; key: ";
+      }
+      return result;
+    }();
+    return source;
+  }
+
+  void BM_RegexTokenIterator(benchmark::State& state) {
+    const std::regex sep_pattern{"[[:s:]]*[,;.:][[:s:]]*"};
+    for (auto _ : state) {
+      std::size_t count{0};
+      for (std::sregex_token_iterator itr{source().begin(), source().end(), sep_pattern, {-1}}, end{}; itr != end; ++itr) {
+        count += itr->length() != 0;
+      }
+      benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(state.iterations() * source().size());
+  }
+
+  void BM_Tokenizer(benchmark::State& state) {
+    for (auto _ : state) {
+      std::size_t count{0};
+      for (auto token : my::tokenizer{source()}) {
+        count += !token.empty();
+      }
+      benchmark::DoNotOptimize(count);
+    }
+    state.SetBytesProcessed(state.iterations() * source().size());
+  }
+}
+
+BENCHMARK(BM_RegexTokenIterator)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_Tokenizer)->Unit(benchmark::kMicrosecond);
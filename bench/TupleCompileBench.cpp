@@ -0,0 +1,179 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/Reflection.h"
+
+#include <tuple>
+
+/**
+ * Compile time benchmark: a reflected struct with 100 members, going through every
+ * tuple algorithm and every reflection derived operator. Time the compilation of this file with:
+ *   cmake --build <build dir> --target LearningModernCppBench -- CMakeFiles/LearningModernCppBench.dir/bench/TupleCompileBench.cpp.o
+ * The fold expression based TupleUtil.h keeps the instantiation depth constant for such wide tuples
+ * (recursive version needed 100 nested instantiations for every distinct functor)
+ * Run time of the same operations is measured as well
+ */
+
+namespace {
+  struct Wide {
+    auto reflect() const { return std::tie(_m0, _m1, _m2, _m3, _m4, _m5, _m6, _m7, _m8, _m9, _m10, _m11, _m12, _m13, _m14, _m15, _m16, _m17, _m18, _m19, _m20, _m21, _m22, _m23, _m24, _m25, _m26, _m27, _m28, _m29, _m30, _m31, _m32, _m33, _m34, _m35, _m36, _m37, _m38, _m39, _m40, _m41, _m42, _m43, _m44, _m45, _m46, _m47, _m48, _m49, _m50, _m51, _m52, _m53, _m54, _m55, _m56, _m57, _m58, _m59, _m60, _m61, _m62, _m63, _m64, _m65, _m66, _m67, _m68, _m69, _m70, _m71, _m72, _m73, _m74, _m75, _m76, _m77, _m78, _m79, _m80, _m81, _m82, _m83, _m84, _m85, _m86, _m87, _m88, _m89, _m90, _m91, _m92, _m93, _m94, _m95, _m96, _m97, _m98, _m99); }
+    auto mut_reflect() { return std::tie(_m0, _m1, _m2, _m3, _m4, _m5, _m6, _m7, _m8, _m9, _m10, _m11, _m12, _m13, _m14, _m15, _m16, _m17, _m18, _m19, _m20, _m21, _m22, _m23, _m24, _m25, _m26, _m27, _m28, _m29, _m30, _m31, _m32, _m33, _m34, _m35, _m36, _m37, _m38, _m39, _m40, _m41, _m42, _m43, _m44, _m45, _m46, _m47, _m48, _m49, _m50, _m51, _m52, _m53, _m54, _m55, _m56, _m57, _m58, _m59, _m60, _m61, _m62, _m63, _m64, _m65, _m66, _m67, _m68, _m69, _m70, _m71, _m72, _m73, _m74, _m75, _m76, _m77, _m78, _m79, _m80, _m81, _m82, _m83, _m84, _m85, _m86, _m87, _m88, _m89, _m90, _m91, _m92, _m93, _m94, _m95, _m96, _m97, _m98, _m99); }
+
+    int _m0{0};
+    int _m1{1};
+    int _m2{2};
+    int _m3{3};
+    int _m4{4};
+    int _m5{5};
+    int _m6{6};
+    int _m7{7};
+    int _m8{8};
+    int _m9{9};
+    int _m10{10};
+    int _m11{11};
+    int _m12{12};
+    int _m13{13};
+    int _m14{14};
+    int _m15{15};
+    int _m16{16};
+    int _m17{17};
+    int _m18{18};
+    int _m19{19};
+    int _m20{20};
+    int _m21{21};
+    int _m22{22};
+    int _m23{23};
+    int _m24{24};
+    int _m25{25};
+    int _m26{26};
+    int _m27{27};
+    int _m28{28};
+    int _m29{29};
+    int _m30{30};
+    int _m31{31};
+    int _m32{32};
+    int _m33{33};
+    int _m34{34};
+    int _m35{35};
+    int _m36{36};
+    int _m37{37};
+    int _m38{38};
+    int _m39{39};
+    int _m40{40};
+    int _m41{41};
+    int _m42{42};
+    int _m43{43};
+    int _m44{44};
+    int _m45{45};
+    int _m46{46};
+    int _m47{47};
+    int _m48{48};
+    int _m49{49};
+    int _m50{50};
+    int _m51{51};
+    int _m52{52};
+    int _m53{53};
+    int _m54{54};
+    int _m55{55};
+    int _m56{56};
+    int _m57{57};
+    int _m58{58};
+    int _m59{59};
+    int _m60{60};
+    int _m61{61};
+    int _m62{62};
+    int _m63{63};
+    int _m64{64};
+    int _m65{65};
+    int _m66{66};
+    int _m67{67};
+    int _m68{68};
+    int _m69{69};
+    int _m70{70};
+    int _m71{71};
+    int _m72{72};
+    int _m73{73};
+    int _m74{74};
+    int _m75{75};
+    int _m76{76};
+    int _m77{77};
+    int _m78{78};
+    int _m79{79};
+    int _m80{80};
+    int _m81{81};
+    int _m82{82};
+    int _m83{83};
+    int _m84{84};
+    int _m85{85};
+    int _m86{86};
+    int _m87{87};
+    int _m88{88};
+    int _m89{89};
+    int _m90{90};
+    int _m91{91};
+    int _m92{92};
+    int _m93{93};
+    int _m94{94};
+    int _m95{95};
+    int _m96{96};
+    int _m97{97};
+    int _m98{98};
+    int _m99{99};
+  };
+
+  void BM_WideForEach(benchmark::State& state) {
+    const Wide wide{};
+    for (auto _ : state) {
+      long sum{0};
+      tuple_for_each(wide.reflect(), [&sum](int elem_) { sum += elem_; });
+      benchmark::DoNotOptimize(sum);
+    }
+  }
+
+  void BM_WideAnyOf(benchmark::State& state) {
+    const Wide wide{};
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(tuple_any_of(wide.reflect(), [](int elem_) { return elem_ == 50; }));
+    }
+  }
+
+  void BM_WideEquality(benchmark::State& state) {
+    const Wide left{};
+    Wide right{};
+    right._m99 = -1;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(left == right);
+    }
+  }
+
+  // differs at the very first member, hence the rest must not be compared
+  void BM_WideOrderingEarlyExit(benchmark::State& state) {
+    const Wide left{};
+    Wide right{};
+    right._m0 = -1;
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(left < right);
+    }
+  }
+
+  void BM_WideHash(benchmark::State& state) {
+    const Wide wide{};
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(my::reflection_hash<Wide>{}(wide));
+    }
+  }
+
+  void BM_WideMutate(benchmark::State& state) {
+    Wide wide{};
+    for (auto _ : state) {
+      tuple_for_each_indexed(wide.mut_reflect(), [](auto index_, int& elem_) { elem_ += static_cast<int>(index_()); });
+      benchmark::DoNotOptimize(wide);
+    }
+  }
+}
+
+BENCHMARK(BM_WideForEach);
+BENCHMARK(BM_WideAnyOf);
+BENCHMARK(BM_WideEquality);
+BENCHMARK(BM_WideOrderingEarlyExit);
+BENCHMARK(BM_WideHash);
+BENCHMARK(BM_WideMutate);
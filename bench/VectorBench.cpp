@@ -0,0 +1,68 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/Vector.h"
+
+#include <numeric>
+
+/**
+ * Sums up a fully populated vector through operator[] in a tight loop
+ * Unchecked static_vector is expected to be on par with the raw array, as both compile to the same loop
+ * (compare the disassembly of sum<> instantiations to verify), while checked one pays for a compare
+ * and a (never taken) throw on every access, which also stops the loop from getting vectorized
+ */
+
+namespace {
+  constexpr std::size_t size{4096};
+
+  template <typename Vector>
+  Vector make_vector() {
+    Vector vector{};
+    for (std::size_t i = 0; i < size; ++i) {
+      vector.push_back(i);
+    }
+    return vector;
+  }
+
+  template <typename Vector>
+  std::size_t sum(const Vector& vector) {
+    std::size_t total{0};
+    for (std::size_t i = 0; i < size; ++i) {
+      total += vector[i];
+    }
+    return total;
+  }
+
+  void BM_RawArray(benchmark::State& state) {
+    static std::size_t values[size];
+    std::iota(std::begin(values), std::end(values), std::size_t{0});
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(values);
+      benchmark::DoNotOptimize(sum(values));
+    }
+  }
+
+  template <my::access_policy Policy>
+  void BM_StaticVector(benchmark::State& state) {
+    static const auto vector = make_vector<my::static_vector<std::size_t, size, Policy>>();
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(vector);
+      benchmark::DoNotOptimize(sum(vector));
+    }
+  }
+
+  template <my::access_policy Policy>
+  void BM_SmallVector(benchmark::State& state) {
+    const auto vector = make_vector<my::small_vector<std::size_t, 16, Policy>>();
+    for (auto _ : state) {
+      benchmark::DoNotOptimize(vector);
+      benchmark::DoNotOptimize(sum(vector));
+    }
+  }
+}
+
+BENCHMARK(BM_RawArray);
+BENCHMARK_TEMPLATE(BM_StaticVector, my::access_policy::checked);
+BENCHMARK_TEMPLATE(BM_StaticVector, my::access_policy::debug_checked);
+BENCHMARK_TEMPLATE(BM_StaticVector, my::access_policy::unchecked);
+BENCHMARK_TEMPLATE(BM_SmallVector, my::access_policy::checked);
+BENCHMARK_TEMPLATE(BM_SmallVector, my::access_policy::unchecked);
@@ -0,0 +1,218 @@
+#include <benchmark/benchmark.h>
+
+#include "../include/WordContainer.h"
+
+#include <algorithm>
+#include <memory_resource>
+#include <random>
+#include <thread>
+#include <string>
+#include <vector>
+
+/**
+ * Latency of WordContainer::get on a Zipf distributed trace of racks (8 letter queries),
+ * where popular racks (and their anagrams) repeat a lot: without and with the result cache,
+ * and strong scaling of the parallel get, from 1 thread up to all the cores
+ * Also cost of building the container, from the heap and from a monotonic arena,
+ * and latency of finding the words an edit away from a misspelled word: through the similar index,
+ * and by trying every single char edit of it against contains()
+ */
+
+namespace {
+  const std::vector<std::string>& dictionary() {
+    static const auto words = [] {
+      std::mt19937 generator{7};
+      std::uniform_int_distribution<int> letter{'a', 'z'};
+      std::uniform_int_distribution<std::size_t> length{2, 8};
+
+      std::vector<std::string> result(50000);
+      for (auto& word : result) {
+        word.resize(length(generator));
+        for (auto& c : word) {
+          c = static_cast<char>(letter(generator));
+        }
+      }
+      return result;
+    }();
+    return words;
+  }
+
+  void fill(WordContainer& container_) {
+    for (const auto& word : dictionary()) {
+      container_.add(word);
+    }
+  }
+
+  WordContainer makeContainer() {
+    WordContainer container{};
+    fill(container);
+    return container;
+  }
+
+  const std::vector<std::string>& trace() {
+    static const auto queries = [] {
+      std::mt19937 generator{42};
+      std::uniform_int_distribution<int> letter{'a', 'z'};
+
+      std::vector<std::string> racks(10000, std::string(8, ' '));
+      std::vector<double> weights(racks.size());
+      for (std::size_t i = 0; i < racks.size(); ++i) {
+        for (auto& c : racks[i]) {
+          c = static_cast<char>(letter(generator));
+        }
+        weights[i] = 1.0 / static_cast<double>(i + 1);
+      }
+
+      std::discrete_distribution<std::size_t> zipf{weights.begin(), weights.end()};
+      std::vector<std::string> result(100000);
+      for (auto& query : result) {
+        query = racks[zipf(generator)];
+        std::shuffle(query.begin(), query.end(), generator); // an anagram of the rack
+      }
+      return result;
+    }();
+    return queries;
+  }
+
+  void runTrace(benchmark::State& state, WordContainer& container_) {
+    std::vector<std::string_view> words{};
+    words.reserve(256);
+    std::size_t index{0};
+    for (auto _ : state) {
+      words.clear();
+      container_.get(trace()[index], std::back_inserter(words));
+      benchmark::DoNotOptimize(words.data());
+      index = (index + 1) % trace().size();
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  void BM_WordContainerGet(benchmark::State& state) {
+    auto container = makeContainer();
+    runTrace(state, container);
+  }
+
+  void BM_WordContainerGetCached(benchmark::State& state) {
+    auto container = makeContainer();
+    container.enableResultCache(static_cast<std::size_t>(state.range(0)));
+    runTrace(state, container);
+  }
+
+  void BM_WordContainerGetParallel(benchmark::State& state) {
+    auto container = makeContainer();
+    my::thread_pool pool{static_cast<std::size_t>(state.range(0))};
+
+    std::vector<std::string_view> words{};
+    words.reserve(256);
+    std::size_t index{0};
+    for (auto _ : state) {
+      words.clear();
+      container.get(trace()[index], std::back_inserter(words), pool);
+      benchmark::DoNotOptimize(words.data());
+      index = (index + 1) % trace().size();
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  void BM_WordContainerBuild(benchmark::State& state) {
+    for (auto _ : state) {
+      WordContainer container{};
+      fill(container);
+      benchmark::DoNotOptimize(&container);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(dictionary().size()));
+  }
+
+  void BM_WordContainerBuildArena(benchmark::State& state) {
+    std::vector<std::byte> buffer(8 << 20); // reused across the iterations
+    for (auto _ : state) {
+      std::pmr::monotonic_buffer_resource arena{buffer.data(), buffer.size()};
+      {
+        WordContainer container{&arena};
+        fill(container);
+        benchmark::DoNotOptimize(&container);
+      }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(dictionary().size()));
+  }
+
+  // dictionary words with a random char deleted, inserted or substituted
+  const std::vector<std::string>& misspelled() {
+    static const auto queries = [] {
+      std::mt19937 generator{3};
+      std::uniform_int_distribution<int> letter{'a', 'z'};
+      std::uniform_int_distribution<std::size_t> word{0, dictionary().size() - 1};
+      std::vector<std::string> result(10000);
+      for (auto& query : result) {
+        query = dictionary()[word(generator)];
+        const auto position = std::uniform_int_distribution<std::size_t>{0, query.size() - 1}(generator);
+        switch (generator() % 3) {
+          case 0: query.erase(position, 1); break;
+          case 1: query.insert(position, 1, static_cast<char>(letter(generator))); break;
+          default: query[position] = static_cast<char>(letter(generator)); break;
+        }
+      }
+      return result;
+    }();
+    return queries;
+  }
+
+  void BM_WordContainerSimilar(benchmark::State& state) {
+    auto container = makeContainer();
+    container.enableSimilarIndex();
+
+    std::vector<std::string_view> words{};
+    words.reserve(256);
+    std::size_t index{0};
+    for (auto _ : state) {
+      words.clear();
+      container.getSimilar(misspelled()[index], std::back_inserter(words));
+      benchmark::DoNotOptimize(words.data());
+      index = (index + 1) % misspelled().size();
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+
+  // the fallback the index replaces: 52 insertions and 52 substitutions per position, and the deletions
+  void BM_WordContainerSimilarByEdits(benchmark::State& state) {
+    auto container = makeContainer();
+    std::string letters{};
+    for (char c = 'a'; c <= 'z'; ++c) {
+      letters += c;
+      letters += static_cast<char>(c - 'a' + 'A');
+    }
+
+    std::size_t index{0};
+    for (auto _ : state) {
+      const auto& query = misspelled()[index];
+      std::size_t found{container.contains(query)};
+      std::string edit{};
+      for (std::size_t i = 0; i <= query.size(); ++i) {
+        if (i < query.size()) {
+          edit = query;
+          found += container.contains(edit.erase(i, 1));
+        }
+        for (auto c : letters) {
+          edit = query;
+          found += container.contains(edit.insert(i, 1, c));
+          if (i < query.size()) {
+            edit = query;
+            edit[i] = c;
+            found += container.contains(edit);
+          }
+        }
+      }
+      benchmark::DoNotOptimize(found);
+      index = (index + 1) % misspelled().size();
+    }
+    state.SetItemsProcessed(state.iterations());
+  }
+}
+
+BENCHMARK(BM_WordContainerBuild);
+BENCHMARK(BM_WordContainerBuildArena);
+BENCHMARK(BM_WordContainerSimilar);
+BENCHMARK(BM_WordContainerSimilarByEdits);
+BENCHMARK(BM_WordContainerGet);
+BENCHMARK(BM_WordContainerGetParallel)->DenseRange(1, std::max(1u, std::thread::hardware_concurrency()))->UseRealTime();
+BENCHMARK(BM_WordContainerGetCached)->Arg(100)->Arg(1000)->Arg(10000);
@@ -0,0 +1,188 @@
+#pragma once
+
+#include "Reflection.h"
+#include "TupleUtil.h"
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+/**
+ * Binary encoding of the types exposing reflect() (and mut_reflect() for decoding)
+ * straight into a caller provided contiguous buffer, without any iostream involved
+ *  => integers (and enums, bool) are written in fixed width little-endian
+ *  => floating point values are written as the little-endian integer of the same width
+ *  => strings are length prefixed (uint32_t) and are NOT null terminated
+ *  => reflectable members are encoded recursively, member after member, without any padding
+ *
+ * Decoding into std::string_view members doesn't copy: views refer to the bytes in the buffer,
+ * hence the buffer must outlive such objects
+ */
+
+namespace my {
+
+  namespace detail {
+    template <typename T>
+    constexpr bool is_fixed_width_v = std::is_arithmetic_v<T> || std::is_enum_v<T>;
+
+    // unsigned integer of the same width as T, which is what actually gets written
+    template <typename T>
+    using wire_t = std::conditional_t<sizeof(T) == 1, std::uint8_t,
+                   std::conditional_t<sizeof(T) == 2, std::uint16_t,
+                   std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>>;
+
+    using length_t = std::uint32_t;
+  }
+
+  class binary_writer {
+  public:
+    binary_writer(char* buffer_, std::size_t size_) noexcept : _buffer(buffer_), _size(size_) {}
+
+    template <typename T>
+    binary_writer& write(const T& value_) {
+      if constexpr (detail::is_fixed_width_v<T>) {
+        static_assert(sizeof(T) <= 8, "Only up to 64 bit wide values are supported");
+        detail::wire_t<T> wire{};
+        std::memcpy(&wire, &value_, sizeof(T));
+
+        // shifts are endian agnostic, and compilers turn this into a plain store on little-endian machines
+        char* out = reserve(sizeof(T));
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+          out[i] = static_cast<char>(static_cast<std::uint8_t>(wire >> (8 * i)));
+        }
+      }
+      else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        const std::string_view str{value_};
+        if (str.size() > std::numeric_limits<detail::length_t>::max()) {
+          throw std::runtime_error{"String is too long to be serialized"};
+        }
+        write(static_cast<detail::length_t>(str.size()));
+        std::memcpy(reserve(str.size()), str.data(), str.size());
+      }
+      else {
+        static_assert(is_reflectable_v<T>, "Type must either be arithmetic, a string or expose reflect()");
+        tuple_for_each(value_.reflect(), [this](const auto& elem_) { write(elem_); });
+      }
+
+      return *this;
+    }
+
+    // number of bytes written so far
+    std::size_t size() const noexcept {
+      return _offset;
+    }
+
+  private:
+    char* reserve(std::size_t count) {
+      if (count > _size - _offset) {
+        throw std::runtime_error{"Buffer is too small"};
+      }
+      char* out = _buffer + _offset;
+      _offset += count;
+      return out;
+    }
+
+    char* _buffer;
+    std::size_t _size;
+    std::size_t _offset{0};
+  };
+
+  class binary_reader {
+  public:
+    binary_reader(const char* buffer_, std::size_t size_) noexcept : _buffer(buffer_), _size(size_) {}
+
+    template <typename T>
+    binary_reader& read(T& value_) {
+      if constexpr (detail::is_fixed_width_v<T>) {
+        const char* in = consume(sizeof(T));
+        detail::wire_t<T> wire{0};
+        for (std::size_t i = 0; i < sizeof(T); ++i) {
+          wire |= static_cast<detail::wire_t<T>>(static_cast<std::uint8_t>(in[i])) << (8 * i);
+        }
+        std::memcpy(&value_, &wire, sizeof(T));
+      }
+      else if constexpr (std::is_same_v<T, std::string_view>) {
+        value_ = read_view();
+      }
+      else if constexpr (std::is_same_v<T, std::string>) {
+        value_.assign(read_view());
+      }
+      else if constexpr (std::is_constructible_v<T, std::string_view> && !is_mut_reflectable_v<T>) {
+        value_ = T{read_view()}; // other string types, e.g. my::interned_string
+      }
+      else {
+        static_assert(is_mut_reflectable_v<T>, "Type must either be arithmetic, a string or expose mut_reflect()");
+        tuple_for_each(value_.mut_reflect(), [this](auto& elem_) { read(elem_); });
+      }
+
+      return *this;
+    }
+
+    template <typename T>
+    T read() {
+      T value{};
+      read(value);
+      return value;
+    }
+
+    // number of bytes consumed so far
+    std::size_t size() const noexcept {
+      return _offset;
+    }
+
+    bool empty() const noexcept {
+      return _offset == _size;
+    }
+
+  private:
+    std::string_view read_view() {
+      const auto length = read<detail::length_t>();
+      return std::string_view{consume(length), length};
+    }
+
+    const char* consume(std::size_t count) {
+      if (count > _size - _offset) {
+        throw std::runtime_error{"Unexpected end of buffer"};
+      }
+      const char* in = _buffer + _offset;
+      _offset += count;
+      return in;
+    }
+
+    const char* _buffer;
+    std::size_t _size;
+    std::size_t _offset{0};
+  };
+
+  // exact number of bytes @value_ is going to take in the buffer
+  template <typename T>
+  std::size_t binary_size(const T& value_) {
+    if constexpr (detail::is_fixed_width_v<T>) {
+      return sizeof(T);
+    }
+    else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+      return sizeof(detail::length_t) + std::string_view{value_}.size();
+    }
+    else {
+      std::size_t size{0};
+      tuple_for_each(value_.reflect(), [&size](const auto& elem_) { size += binary_size(elem_); });
+      return size;
+    }
+  }
+
+  // returns number of bytes written, throws std::runtime_error if buffer is too small
+  template <typename T>
+  std::size_t serialize(const T& value_, char* buffer_, std::size_t size_) {
+    return binary_writer{buffer_, size_}.write(value_).size();
+  }
+
+  // returns number of bytes consumed, throws std::runtime_error if buffer ends prematurely
+  template <typename T>
+  std::size_t deserialize(T& value_, const char* buffer_, std::size_t size_) {
+    return binary_reader{buffer_, size_}.read(value_).size();
+  }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Split block Bloom filter over 64 bit keys (same layout as the one in Apache Parquet/Impala):
+ * the filter is an array of 32 byte blocks of 8 32-bit words, a key maps to one block, and sets
+ * (or checks) exactly one bit in each of the 8 words of it.
+ * Hence a lookup touches a single cache line, and checking the 8 words is branch free
+ * (and vectorizable), which is what makes it worth checking before a hash map probe that's likely to miss.
+ * No false negatives, false positive rate is ~0.5% at 16 bits per key
+ */
+
+namespace my {
+
+  class blocked_bloom_filter {
+  public:
+
+    static constexpr std::size_t default_bits_per_key{16};
+
+    // sized for @capacity_ keys, can hold more of them (at a higher false positive rate)
+    explicit blocked_bloom_filter(std::size_t capacity_ = 0, std::size_t bits_per_key_ = default_bits_per_key) :
+    _blocks(std::max<std::size_t>(1, (capacity_ * bits_per_key_ + block_bits - 1) / block_bits)),
+    _capacity(capacity_) {}
+
+    void insert(std::uint64_t key_) noexcept {
+      const auto hash = mix(key_);
+      auto& words = _blocks[block_index(hash)].words;
+      for (std::size_t i = 0; i < word_count; ++i) {
+        words[i] |= bit(hash, i);
+      }
+      ++_size;
+    }
+
+    // false means that @key_ was definitely never inserted
+    bool may_contain(std::uint64_t key_) const noexcept {
+      const auto hash = mix(key_);
+      const auto& words = _blocks[block_index(hash)].words;
+      std::uint32_t missing{0};
+      for (std::size_t i = 0; i < word_count; ++i) {
+        missing |= ~words[i] & bit(hash, i);
+      }
+      return missing == 0;
+    }
+
+    // number of insert() calls
+    std::size_t size() const noexcept {
+      return _size;
+    }
+
+    std::size_t capacity() const noexcept {
+      return _capacity;
+    }
+
+    // in bytes
+    std::size_t memory() const noexcept {
+      return _blocks.size() * sizeof(block);
+    }
+
+  private:
+    static constexpr std::size_t word_count{8};
+    static constexpr std::size_t block_bits{word_count * 32};
+
+    struct alignas(32) block {
+      std::array<std::uint32_t, word_count> words{};
+    };
+
+    // odd constants, one per word, picking the bit to set in it
+    static constexpr std::array<std::uint32_t, word_count> salts{
+      0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+    // keys (e.g. products of primes) are far from uniformly distributed, hence the splitmix64 finalizer
+    static std::uint64_t mix(std::uint64_t key_) noexcept {
+      key_ = (key_ ^ (key_ >> 30)) * 0xbf58476d1ce4e5b9ULL;
+      key_ = (key_ ^ (key_ >> 27)) * 0x94d049bb133111ebULL;
+      return key_ ^ (key_ >> 31);
+    }
+
+    // upper half of the hash picks the block (multiply-shift, instead of modulo)
+    std::size_t block_index(std::uint64_t hash_) const noexcept {
+      return static_cast<std::size_t>(((hash_ >> 32) * _blocks.size()) >> 32);
+    }
+
+    // lower half picks the bits
+    static std::uint32_t bit(std::uint64_t hash_, std::size_t word_) noexcept {
+      return std::uint32_t{1} << ((static_cast<std::uint32_t>(hash_) * salts[word_]) >> 27);
+    }
+
+    std::vector<block> _blocks;
+    std::size_t _capacity;
+    std::size_t _size{0};
+  };
+}
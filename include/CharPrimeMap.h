@@ -1,5 +1,10 @@
-#include "Vector.h"
-#include "algorithm.h"
+#pragma once
+
+#include "Primes.h"
+
+#include <array>
+#include <cstddef>
+#include <stdexcept>
 
 
 namespace my {
@@ -7,9 +12,7 @@ namespace my {
 
   public:
 
-    constexpr alphabet_char_prime_map() {
-      fill_primes();
-    }
+    constexpr alphabet_char_prime_map() = default;
 
     constexpr std::size_t prime(char c) const {
       return _values[index(c)];
@@ -32,40 +35,14 @@ namespace my {
       }
     }
 
-    constexpr bool is_prime(size_t num) const noexcept {
-      auto itr = my::find_if(_values.begin(), _values.end(), [num](auto prime){ return (num % prime) == 0; });
-      return itr == _values.end();
-    }
-
-    constexpr void fill_primes() {
-
-      // pushing few initial values
-      _values.push_back(2);
-      _values.push_back(3);
-      _values.push_back(5);
-      _values.push_back(7);
-      _values.push_back(11);
-      _values.push_back(13);
-      _values.push_back(17);
-      std::size_t last_prime{_values.back()};
-
-      while(_values.size() != _maxSize) {
-        for (std::size_t number = last_prime+2; ; number += 2) {
-          if (is_prime(number)) {
-            last_prime = number;
-            _values.push_back(number);
-            break;
-          }
-        }
-      }
-    }
-
     static constexpr char lc_first{'a'};
     static constexpr char lc_last{'z'};
     static constexpr char uc_first{'A'};
     static constexpr char uc_last{'Z'};
 
     static constexpr size_t _maxSize{52};
-    static_vector<size_t, _maxSize> _values{};
+
+    // shared by all the instances, and computed at compile time even when instance is created at runtime
+    static constexpr std::array<std::size_t, _maxSize> _values{make_prime_table<_maxSize>()};
   };
 }
\ No newline at end of file
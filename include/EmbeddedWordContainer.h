@@ -0,0 +1,136 @@
+#pragma once
+
+#include "CharPrimeMap.h"
+#include "algorithm.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+/**
+ * Fixed dictionary baked into the binary: same queries as WordContainer, but keys are computed,
+ * sorted and deduplicated at compile time, hence nothing to build at startup
+ *
+ *   static constexpr EmbeddedWordContainer dictionary{"wo", "wom", "me", "men", "women"};
+ *
+ * Words live in a single char blob, entries (key, offset, length) are sorted by key and
+ * looked up by binary search. As in WordContainer, the first word added wins among anagrams
+ * get() writes std::string_views into the blob, which are valid for the lifetime of the container
+ */
+
+template <std::size_t WordCount, std::size_t BlobSize>
+class EmbeddedWordContainer {
+public:
+  using key_t = uint64_t;
+
+  // same limit as WordContainer
+  static constexpr std::size_t max_key_width{8};
+
+  template <std::size_t... N>
+  constexpr explicit EmbeddedWordContainer(const char (&... words)[N]) {
+    (add(std::string_view{words, N - 1}), ...);
+    sort();
+    unique();
+  }
+
+  // number of distinct keys (anagrams of an earlier word are dropped)
+  constexpr std::size_t size() const noexcept {
+    return _size;
+  }
+
+  constexpr bool contains(std::string_view str) const {
+    return find(getKey(str)) != _size;
+  }
+
+  // only first max_key_width chars of @str are considered, doesn't allocate
+  template <typename OutItr>
+  constexpr void get(std::string_view str, OutItr outItr) const {
+    const auto query = str.substr(0, max_key_width);
+
+    // products of every subset of the chars (bit i of the index for query[i]), in the same order as WordContainer
+    std::array<key_t, 1ull << max_key_width> products{};
+    products[0] = 1;
+    for (std::size_t i = 1; i < (1ull << query.size()); ++i) {
+      products[i] = products[i & (i - 1)] * _charMap.prime(query[lowestBit(i)]);
+      if (const auto index = find(products[i]); index != _size) {
+        outItr = std::string_view{_blob.data() + _entries[index].offset, _entries[index].length};
+      }
+    }
+  }
+
+private:
+  struct entry {
+    key_t key{0};
+    std::size_t offset{0};
+    std::size_t length{0};
+  };
+
+  static constexpr std::size_t lowestBit(std::size_t i) noexcept {
+    std::size_t bit{0};
+    while ((i & 1) == 0) {
+      i >>= 1;
+      ++bit;
+    }
+    return bit;
+  }
+
+  constexpr key_t getKey(std::string_view str) const {
+    key_t key{1};
+    for (auto c : str) {
+      key *= _charMap.prime(c);
+    }
+    return key;
+  }
+
+  constexpr void add(std::string_view word) {
+    if (word.size() > max_key_width) {
+      throw std::runtime_error{"Length of a word exceeds maximum supported length (8 chars)"};
+    }
+    auto& added = _entries[_size++];
+    added.key = getKey(word);
+    added.offset = _blobSize;
+    added.length = word.size();
+    for (auto c : word) {
+      _blob[_blobSize++] = c;
+    }
+  }
+
+  // by key, and by order of addition among anagrams (offsets grow as words are added)
+  static constexpr bool less(const entry& left, const entry& right) noexcept {
+    return left.key < right.key || (left.key == right.key && left.offset < right.offset);
+  }
+
+  constexpr void sort() {
+    my::sort(_entries.begin(), _entries.begin() + _size, less);
+  }
+
+  // keeps the first added one of the anagrams
+  constexpr void unique() {
+    std::size_t kept{0};
+    for (std::size_t i = 0; i < _size; ++i) {
+      if (kept == 0 || _entries[kept - 1].key != _entries[i].key) {
+        _entries[kept++] = _entries[i];
+      }
+    }
+    _size = kept;
+  }
+
+  // index of the entry of @key, _size if there is none (an index, as comparing pointers isn't always a constant expression)
+  constexpr std::size_t find(key_t key) const noexcept {
+    const auto first = _entries.begin();
+    const auto itr = my::lower_bound(first, first + _size, key, [](const entry& entry_, key_t key_) { return entry_.key < key_; });
+    const auto index = static_cast<std::size_t>(itr - first);
+    return (index < _size && _entries[index].key == key) ? index : _size;
+  }
+
+  my::alphabet_char_prime_map _charMap{};
+  std::array<entry, WordCount> _entries{};
+  std::array<char, BlobSize> _blob{};
+  std::size_t _size{0};
+  std::size_t _blobSize{0};
+};
+
+template <std::size_t... N>
+EmbeddedWordContainer(const char (&... words)[N]) -> EmbeddedWordContainer<sizeof...(N), (0 + ... + (N - 1))>;
@@ -1,27 +1,299 @@
 #pragma once
 
-#include <unordered_map>
+#include "BinarySerialization.h"
+#include "Vector.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <iterator>
 #include <list>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 /**
  * The idea is to use a linked list and a map
  * to implement least-recently-used-cache (LRUCache).
  * Map will act like a cache and linkedList
  * will help finding the least-recently-used-element
+ *
+ * Entries can be saved to a snapshot file (in recency order) and restored from it,
+ * so that a restarted cache doesn't start empty. Restoring can happen in the background,
+ * while the cache already serves hits: decoded entries are handed over in batches,
+ * and the most recent ones first, and are merged into the cache on its own thread by get() and insert()
+ * Evicted entries can be observed through an eviction listener, and instead of being destroyed
+ * inline by insert(), can be handed over to a background thread in batches for destruction
+ *
+ * List nodes and map nodes are allocated by @Allocator (rebound for the map), e.g. PmrLRUCache takes
+ * a std::pmr::memory_resource: an unsynchronized_pool_resource recycles the nodes of evicted entries
+ * without going through the global heap, a monotonic_buffer_resource suits caches that are filled once
+ * Background restore and reclaim allocate and free nodes on their own threads, so with those
+ * the resource has to be thread safe (e.g. synchronized_pool_resource)
+ *
+ * Snapshot is: "LRUS", version (uint32_t), count (uint64_t), followed by the (key, value)s from least
+ * to most recently used, all serialized by my::binary_writer
  */
 
-template<typename Key, typename Value>
+namespace lru_detail {
+  struct identity {
+    template <typename T>
+    const T& operator()(const T& value_) const noexcept {
+      return value_;
+    }
+  };
+
+  constexpr std::uint32_t snapshot_magic{0x5355524c}; // "LRUS" in little-endian
+  constexpr std::uint32_t snapshot_version{1};
+  constexpr std::size_t snapshot_header_size{16};
+
+  inline std::string read_file(const std::string& path_) {
+    std::ifstream file{path_, std::ios::binary | std::ios::ate};
+    if (!file) {
+      throw std::runtime_error{"Unable to open snapshot: " + path_};
+    }
+    std::string bytes(static_cast<std::size_t>(file.tellg()), '\0');
+    file.seekg(0);
+    file.read(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    return bytes;
+  }
+
+  // checks the header, and returns the number of entries
+  inline std::uint64_t read_snapshot_header(my::binary_reader& reader_) {
+    if (reader_.read<std::uint32_t>() != snapshot_magic) {
+      throw std::runtime_error{"Not a snapshot"};
+    }
+    if (reader_.read<std::uint32_t>() != snapshot_version) {
+      throw std::runtime_error{"Unsupported snapshot version"};
+    }
+    return reader_.read<std::uint64_t>();
+  }
+
+  // entries of a snapshot, from least to most recently used
+  template <typename Key, typename Value>
+  std::vector<std::pair<Key, Value>> read_snapshot(const std::string& path_) {
+    const auto bytes = read_file(path_);
+    my::binary_reader reader{bytes.data(), bytes.size()};
+    const auto count = read_snapshot_header(reader);
+    if (count > bytes.size()) {
+      throw std::runtime_error{"Corrupted snapshot: " + path_};
+    }
+
+    std::vector<std::pair<Key, Value>> entries(static_cast<std::size_t>(count));
+    for (auto& entry : entries) {
+      reader.read(entry.first).read(entry.second);
+    }
+    if (!reader.empty()) {
+      throw std::runtime_error{"Corrupted snapshot: " + path_};
+    }
+    return entries;
+  }
+
+  // decodes a snapshot on its own thread, into batches of list nodes, most recently used batch first
+  template <typename List, typename Key, typename Value>
+  class snapshot_loader {
+  public:
+    snapshot_loader(std::string path_, std::size_t batchSize_, typename List::allocator_type allocator_) :
+    _path(std::move(path_)),
+    _batchSize(batchSize_),
+    _allocator(allocator_),
+    _thread([this] { load(); }) {}
+
+    ~snapshot_loader() {
+      cancel();
+      if (_thread.joinable()) {
+        _thread.join();
+      }
+    }
+
+    // batches decoded so far, without waiting for the loader to hand one over unless @block_
+    std::vector<List> take(bool block_) {
+      std::unique_lock<std::mutex> lock{_mutex, std::defer_lock};
+      std::vector<List> batches{};
+      if (block_ ? (lock.lock(), true) : lock.try_lock()) {
+        batches.swap(_batches);
+      }
+      return batches;
+    }
+
+    void wait() {
+      _thread.join();
+      _thread = std::thread{};
+    }
+
+    void cancel() noexcept {
+      _cancelled = true;
+    }
+
+    bool done() const noexcept {
+      return _done;
+    }
+
+    std::exception_ptr error() const noexcept {
+      return _error;
+    }
+
+  private:
+    void load() {
+      try {
+        auto entries = read_snapshot<Key, Value>(_path);
+        for (auto end = entries.size(); end != 0 && !_cancelled; ) {
+          const auto begin = end - std::min(end, _batchSize);
+          List batch{_allocator}; // same allocator as the cache, so that it can be spliced into it
+          for (auto i = begin; i < end; ++i) {
+            batch.emplace_back(std::move(entries[i].first), std::move(entries[i].second));
+          }
+          end = begin;
+
+          std::lock_guard<std::mutex> lock{_mutex};
+          _batches.push_back(std::move(batch));
+        }
+      }
+      catch (...) {
+        _error = std::current_exception();
+      }
+      _done = true;
+    }
+
+    std::string _path;
+    std::size_t _batchSize;
+    typename List::allocator_type _allocator;
+    std::mutex _mutex{};
+    std::vector<List> _batches{};
+    std::exception_ptr _error{};
+    std::atomic<bool> _cancelled{false};
+    std::atomic<bool> _done{false};
+    std::thread _thread; // last, as it starts right away
+  };
+
+  // destroys batches of evicted list nodes on its own thread, which looks for them every @interval_
+  // handing a batch over doesn't wake the thread up, as the woken up thread could preempt
+  // the one handing it over (right in the middle of an insert) when they share a core
+  template <typename List>
+  class reclaimer {
+  public:
+    explicit reclaimer(std::chrono::microseconds interval_) : _interval(interval_), _thread([this] { run(); }) {}
+
+    // pending batches are still destroyed (by the reclaimer thread, before it's joined)
+    ~reclaimer() {
+      {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _stop = true;
+      }
+      _pending.notify_one();
+      _thread.join();
+    }
+
+    void reclaim(List&& batch_) {
+      bool idle{false};
+      {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _batches.push_back(std::move(batch_));
+        idle = _idle;
+      }
+      if (idle) {
+        _pending.notify_one(); // only when it's asleep, a busy one picks the batch up after its interval
+      }
+    }
+
+  private:
+    void run() {
+      std::unique_lock<std::mutex> lock{_mutex};
+      while (true) {
+        // gives the cache an interval to hand over more of them
+        _pending.wait_for(lock, _interval, [this] { return _stop; });
+        if (_batches.empty()) {
+          if (_stop) {
+            return;
+          }
+          // nothing for a whole interval: sleeps until there is something, instead of waking up every interval
+          _idle = true;
+          _pending.wait(lock, [this] { return _stop || !_batches.empty(); });
+          _idle = false;
+          continue;
+        }
+
+        auto batches = std::move(_batches);
+        _batches.clear();
+        lock.unlock();
+        batches.clear(); // that's where the nodes get destroyed
+        lock.lock();
+      }
+    }
+
+    std::chrono::microseconds _interval;
+    std::mutex _mutex{};
+    std::condition_variable _pending{};
+    std::vector<List> _batches{};
+    bool _idle{false};
+    bool _stop{false};
+    std::thread _thread; // last, as it starts right away
+  };
+}
+
+template<typename Key, typename Value, typename Allocator = std::allocator<std::pair<const Key, Value>>>
 class LRUCache {
 public:
 
   // aliases
   using value_type = std::pair<const Key, Value>;
-  using list_type = std::list<value_type>;
+  using allocator_type = Allocator;
+  using list_type = std::list<value_type, Allocator>;
   using iterator = typename list_type::iterator;
   using const_iterator = typename list_type::const_iterator;
-  using cache_type = std::unordered_map<Key, iterator>;
+  using cache_type = std::unordered_map<Key, iterator, std::hash<Key>, std::equal_to<Key>,
+    typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<const Key, iterator>>>;
+  using eviction_listener = std::function<void(const value_type&)>;
+
+  explicit LRUCache(std::size_t size_, const Allocator& allocator_ = Allocator{}) :
+  _maxSize(size_),
+  _cache(typename cache_type::allocator_type{allocator_}),
+  _accessList(allocator_),
+  _evicted(allocator_) {}
+
+  // copies the entries, in the same order, but not the state of a restoreSnapshot() in progress (entries it
+  // hasn't merged yet aren't copied), nor the background reclaimer: the copy destroys its evicted entries itself
+  LRUCache(const LRUCache& other_) :
+  _maxSize(other_._maxSize),
+  _cache(typename cache_type::allocator_type{
+    std::allocator_traits<Allocator>::select_on_container_copy_construction(other_.get_allocator())}),
+  _accessList(other_._accessList),
+  _evictionListener(other_._evictionListener),
+  _evicted(_accessList.get_allocator()) {
+    index();
+  }
 
-  explicit LRUCache(std::size_t size_) : _maxSize(size_) {}
+  // same as above, a reclaimer of this cache is kept
+  LRUCache& operator=(const LRUCache& other_) {
+    if (this != &other_) {
+      _loader.reset(); // it would merge into the replaced entries
+      _maxSize = other_._maxSize;
+      _accessList.clear(); // rather than assigned, as the keys of the entries are const
+      _accessList.insert(_accessList.end(), other_._accessList.begin(), other_._accessList.end());
+      _evictionListener = other_._evictionListener;
+      index();
+    }
+    return *this;
+  }
+
+  LRUCache(LRUCache&&) = default;
+  LRUCache& operator=(LRUCache&&) = default;
+
+  allocator_type get_allocator() const {
+    return _accessList.get_allocator();
+  }
 
   std::size_t size() { return _cache.size(); }
 
@@ -29,6 +301,10 @@ public:
 
   // if the key exists, it is made most recently used key
   iterator get(const Key &key) {
+    if (_loader) {
+      pollRestore();
+    }
+
     auto cacheItr = _cache.find(key);
 
     if (cacheItr != _cache.end()) {
@@ -44,26 +320,66 @@ public:
   // without overwriting the key
   // otherwise, new key-value pair inserted and made most recently used key
   iterator insert(const Key &key, const Value &value) {
-    auto cacheItr = _cache.find(key);
+    return insertValue(key, value);
+  }
 
-    if (cacheItr == _cache.end()) {
-      _accessList.emplace_back(key, value);
-      _cache.emplace(key, lastItr());
+  // same as above, but a new value is moved into the cache
+  iterator insert(const Key &key, Value &&value) {
+    return insertValue(key, std::move(value));
+  }
 
-      if (_cache.size() > _maxSize) {
-        auto firstItr = _accessList.begin();
-        _cache.erase(firstItr->first);
-        _accessList.pop_front();
-      }
+  // same as calling get() for each of the keys, in order, writes the iterators (end() for missing keys) to @out
+  // all the keys are looked up first, and then all the found ones are made most recently used
+  template <typename KeyItr, typename OutItr>
+  OutItr multiGet(KeyItr first, KeyItr last, OutItr out) {
+    if (_loader) {
+      pollRestore();
+    }
 
+    const auto found = lookup(first, last);
+    for (auto itr : found) {
+      if (itr != _accessList.end()) {
+        _accessList.splice(_accessList.end(), _accessList, itr);
+      }
+      *out = itr;
+      ++out;
+    }
+    return out;
+  }
 
-    } else {
-      // just move corresponding listItr to end
-      _accessList.splice(_accessList.end(), _accessList, cacheItr->second);
+  // same as calling insert() for each of the (key, value)s, in order,
+  // except that evictions happen once all of them are inserted (so a key of the batch can't be evicted
+  // before it's reached), returns iterator to the last of them
+  template <typename PairItr>
+  iterator multiInsert(PairItr first, PairItr last) {
+    static_assert(std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<PairItr>::iterator_category>,
+                  "multiInsert goes over the pairs twice");
+    if (_loader) {
+      pollRestore();
     }
 
+    _cache.reserve(_cache.size() + static_cast<std::size_t>(std::distance(first, last)));
 
-    return lastItr();
+    const auto found = lookup(first, last, [](const auto& pair_) -> const Key& { return pair_.first; });
+    auto itr = found.begin();
+    for (; first != last; ++first, ++itr) {
+      if (*itr != _accessList.end()) {
+        _accessList.splice(_accessList.end(), _accessList, *itr);
+        continue;
+      }
+
+      // key might have been inserted by an earlier pair of the batch
+      _accessList.emplace_back(first->first, first->second);
+      if (!_cache.emplace(first->first, lastItr()).second) {
+        _accessList.pop_back();
+        _accessList.splice(_accessList.end(), _accessList, _cache.find(first->first)->second);
+      }
+    }
+
+    while (_cache.size() > _maxSize) {
+      evictFirst();
+    }
+    return found.empty() ? _accessList.end() : lastItr();
   }
 
   void erase(const Key& key) {
@@ -86,13 +402,222 @@ public:
     return _accessList.end();
   }
 
+  // @listener is called with every entry evicted to make room for a new one (not with the erased ones),
+  // right before it's destroyed (or handed over to the background reclaimer)
+  void setEvictionListener(eviction_listener listener) {
+    _evictionListener = std::move(listener);
+  }
+
+  // evicted entries are destroyed on a background thread, in batches of @batchSize,
+  // instead of on the thread calling insert(), the thread looks for the batches every @interval
+  void reclaimInBackground(std::size_t batchSize = 64, std::chrono::microseconds interval = std::chrono::milliseconds{1}) {
+    _reclaimBatchSize = std::max<std::size_t>(batchSize, 1);
+    _reclaimer = std::make_unique<reclaimer_type>(interval);
+  }
+
+  // writes all the entries, from least to most recently used, into the snapshot at @path
+  void saveSnapshot(const std::string& path) const {
+    std::size_t size{lru_detail::snapshot_header_size};
+    for (const auto& entry : _accessList) {
+      size += my::binary_size(entry.first) + my::binary_size(entry.second);
+    }
+
+    std::string bytes(size, '\0');
+    my::binary_writer writer{bytes.data(), bytes.size()};
+    writer.write(lru_detail::snapshot_magic).write(lru_detail::snapshot_version).write(std::uint64_t{_accessList.size()});
+    for (const auto& entry : _accessList) {
+      writer.write(entry.first).write(entry.second);
+    }
+
+    std::ofstream file{path, std::ios::binary | std::ios::trunc};
+    if (!file.write(bytes.data(), static_cast<std::streamsize>(bytes.size()))) {
+      throw std::runtime_error{"Unable to write snapshot: " + path};
+    }
+  }
+
+  // restores the entries of the snapshot at @path, and returns how many of them were restored
+  // restored entries are less recently used than the existing ones, and existing keys aren't overwritten
+  // if there isn't enough room for all of them, only the most recently used ones are restored
+  std::size_t loadSnapshot(const std::string& path) {
+    auto entries = lru_detail::read_snapshot<Key, Value>(path);
+    const auto first = entries.size() - std::min(entries.size(), _maxSize);
+    _cache.reserve(_cache.size() + entries.size() - first);
+
+    list_type batch{_accessList.get_allocator()};
+    for (auto i = first; i < entries.size(); ++i) {
+      batch.emplace_back(std::move(entries[i].first), std::move(entries[i].second));
+    }
+    return merge(std::move(batch));
+  }
+
+  // same as loadSnapshot, but the snapshot is decoded on a background thread,
+  // and entries are restored by get() and insert() as they are decoded
+  void restoreSnapshot(const std::string& path, std::size_t batchSize = 4096) {
+    {
+      std::ifstream file{path, std::ios::binary};
+      if (!file) {
+        throw std::runtime_error{"Unable to open snapshot: " + path};
+      }
+      char header[lru_detail::snapshot_header_size]{};
+      file.read(header, sizeof(header));
+      my::binary_reader reader{header, static_cast<std::size_t>(file.gcount())};
+      const auto count = lru_detail::read_snapshot_header(reader);
+      _cache.reserve(_cache.size() + static_cast<std::size_t>(std::min<std::uint64_t>(count, _maxSize)));
+    }
+
+    _restored = 0;
+    _loader = std::make_unique<loader_type>(path, batchSize, _accessList.get_allocator());
+  }
+
+  // whether a restoreSnapshot() is still in progress
+  bool restoring() const noexcept {
+    return _loader != nullptr;
+  }
+
+  // waits for the restoreSnapshot() in progress to finish, and returns how many entries were restored
+  // rethrows the error, if any, in decoding the snapshot
+  std::size_t finishRestore() {
+    if (_loader) {
+      _loader->wait();
+      pollRestore();
+    }
+    if (_loader) {
+      auto error = _loader->error(); // pollRestore() keeps a failed loader, for its error
+      _loader.reset();
+      std::rethrow_exception(error);
+    }
+    return _restored;
+  }
+
 private:
 
+  using loader_type = lru_detail::snapshot_loader<list_type, Key, Value>;
+  using reclaimer_type = lru_detail::reclaimer<list_type>;
+
+  template <typename V>
+  iterator insertValue(const Key &key, V &&value) {
+    if (_loader) {
+      pollRestore();
+    }
+
+    auto cacheItr = _cache.find(key);
+
+    if (cacheItr == _cache.end()) {
+      _accessList.emplace_back(key, std::forward<V>(value));
+      _cache.emplace(key, lastItr());
+
+      if (_cache.size() > _maxSize) {
+        evictFirst();
+      }
+
+
+    } else {
+      // just move corresponding listItr to end
+      _accessList.splice(_accessList.end(), _accessList, cacheItr->second);
+    }
+
+
+    return lastItr();
+  }
+
+  // looks up the keys, back to back, as they are independent of each other (unlike the splices),
+  // the processor can overlap their cache misses
+  // std::unordered_map can't be probed with precomputed hashes, so the list nodes are what gets prefetched
+  template <typename Itr, typename Projection = lru_detail::identity>
+  my::small_vector<iterator, 256> lookup(Itr first, Itr last, Projection projection = {}) {
+    my::small_vector<iterator, 256> found{};
+    for (; first != last; ++first) {
+      auto cacheItr = _cache.find(projection(*first));
+      if (cacheItr == _cache.end()) {
+        found.push_back(_accessList.end());
+        continue;
+      }
+      found.push_back(cacheItr->second);
+#if defined(__GNUC__)
+      __builtin_prefetch(&*cacheItr->second, 1);
+#endif
+    }
+    return found;
+  }
+
+  void evictFirst() {
+    auto firstItr = _accessList.begin();
+    _cache.erase(firstItr->first);
+
+    if (_evictionListener) {
+      _evictionListener(*firstItr);
+    }
+
+    if (!_reclaimer) {
+      _accessList.pop_front();
+      return;
+    }
+
+    // no destruction here, just relinking the node
+    _evicted.splice(_evicted.end(), _accessList, firstItr);
+    if (_evicted.size() >= _reclaimBatchSize) {
+      _reclaimer->reclaim(std::move(_evicted));
+      _evicted.clear(); // moved-from list is only guaranteed to be valid
+    }
+  }
+
+  // merges the batches decoded so far
+  void pollRestore() {
+    const bool done = _loader->done(); // before taking the batches, so that none of them is left behind
+    for (auto& batch : _loader->take(done)) {
+      _restored += merge(std::move(batch));
+    }
+    if (_cache.size() == _maxSize) {
+      _loader->cancel(); // no room for the rest of them
+    }
+    if (done && !_loader->error()) {
+      _loader.reset();
+    }
+  }
+
+  // moves the nodes of @batch (least to most recently used) in front of the existing ones,
+  // as long as there is room for them, and returns the number of nodes moved
+  std::size_t merge(list_type&& batch) {
+    auto room = _maxSize - std::min(_maxSize, _cache.size());
+    for (auto itr = batch.end(); itr != batch.begin(); ) {
+      --itr;
+      if (room == 0 || _cache.find(itr->first) != _cache.end()) {
+        itr = batch.erase(itr);
+        continue;
+      }
+      _cache.emplace(itr->first, itr);
+      --room;
+    }
+
+    const auto count = batch.size();
+    _accessList.splice(_accessList.begin(), batch);
+    return count;
+  }
+
   iterator lastItr() {
     return std::prev(_accessList.end());
   }
 
+  // points _cache to the nodes of _accessList
+  void index() {
+    _cache.clear();
+    _cache.reserve(_accessList.size());
+    for (auto itr = _accessList.begin(); itr != _accessList.end(); ++itr) {
+      _cache.emplace(itr->first, itr);
+    }
+  }
+
   std::size_t _maxSize;
-  cache_type _cache{};
-  list_type _accessList{};
-};
\ No newline at end of file
+  cache_type _cache;
+  list_type _accessList;
+  std::unique_ptr<loader_type> _loader{};
+  std::size_t _restored{0};
+  eviction_listener _evictionListener{};
+  list_type _evicted; // waiting to be handed over to the reclaimer
+  std::size_t _reclaimBatchSize{0};
+  std::unique_ptr<reclaimer_type> _reclaimer{}; // after _evicted, so that it's destroyed first
+};
+
+// nodes come from a std::pmr::memory_resource
+template <typename Key, typename Value>
+using PmrLRUCache = LRUCache<Key, Value, std::pmr::polymorphic_allocator<std::pair<const Key, Value>>>;
@@ -0,0 +1,588 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+/**
+ * Patterns compiled at compile time, as an alternative to std::regex for fixed patterns:
+ * std::regex parses its pattern at runtime on every construction and matches by backtracking.
+ *
+ * my::pattern compiles a linear regular expression (a sequence of characters and classes,
+ * each optionally followed by *, + or ?) into a DFA in a constexpr constructor:
+ *   static constexpr my::pattern<> sep_pattern{"[[:s:]]*[,;.:][[:s:]]*"};
+ * Supported syntax: literals, '.', escapes (\s \S \d \D \w \W \t \n \r \f \v and escaped punctuation),
+ * bracket expressions with ranges, negation and [:s:], [:space:], [:d:], [:digit:], [:w:], [:alpha:],
+ * [:alnum:], [:upper:], [:lower:], [:punct:]. Anything else (groups, alternation, anchors, counted
+ * repetition, backreferences) throws std::runtime_error, which is a compile error in constant expressions.
+ * Matches are leftmost-longest (POSIX), which, for the patterns used here, is also what std::regex finds.
+ *
+ * my::tag_pattern is a dedicated matcher for the backreferenced "<(.*)>(.*)<(\1)>" pattern,
+ * giving the same groups as std::regex (ECMAScript, greedy).
+ */
+
+namespace my {
+
+  // std::match_results like view of a match, groups refer to the searched text
+  template <std::size_t Groups>
+  class match_results {
+  public:
+    constexpr match_results() noexcept = default;
+
+    constexpr match_results(std::string_view source_, const std::array<std::string_view, Groups + 1>& groups_) noexcept :
+    _source(source_), _groups(groups_), _matched(true) {}
+
+    explicit constexpr operator bool() const noexcept {
+      return _matched;
+    }
+
+    // whole match and the groups, 0 if there was no match
+    constexpr std::size_t size() const noexcept {
+      return _matched ? Groups + 1 : 0;
+    }
+
+    constexpr std::string_view operator[](std::size_t index_) const noexcept {
+      return _groups[index_];
+    }
+
+    constexpr std::string_view str() const noexcept {
+      return _groups[0];
+    }
+
+    constexpr std::size_t position() const noexcept {
+      return static_cast<std::size_t>(_groups[0].data() - _source.data());
+    }
+
+    constexpr std::string_view prefix() const noexcept {
+      return _matched ? _source.substr(0, position()) : std::string_view{};
+    }
+
+    constexpr std::string_view suffix() const noexcept {
+      return _matched ? _source.substr(position() + _groups[0].size()) : std::string_view{};
+    }
+
+  private:
+    std::string_view _source{};
+    std::array<std::string_view, Groups + 1> _groups{};
+    bool _matched{false};
+  };
+
+  namespace detail {
+
+    // set of bytes, usable in constant expressions (which std::bitset isn't in C++17)
+    class byte_set {
+    public:
+      constexpr void set(unsigned char c_) noexcept {
+        _bits[c_ >> 6] |= std::uint64_t{1} << (c_ & 63);
+      }
+
+      constexpr void set(unsigned char first_, unsigned char last_) noexcept {
+        for (unsigned c = first_; c <= last_; ++c) {
+          set(static_cast<unsigned char>(c));
+        }
+      }
+
+      constexpr void set(const byte_set& other_) noexcept {
+        for (std::size_t i = 0; i < _bits.size(); ++i) {
+          _bits[i] |= other_._bits[i];
+        }
+      }
+
+      constexpr void flip() noexcept {
+        for (auto& bits : _bits) {
+          bits = ~bits;
+        }
+      }
+
+      constexpr bool test(unsigned char c_) const noexcept {
+        return (_bits[c_ >> 6] >> (c_ & 63)) & 1;
+      }
+
+    private:
+      std::array<std::uint64_t, 4> _bits{};
+    };
+
+    constexpr byte_set make_byte_set(std::string_view chars_) noexcept {
+      byte_set set{};
+      for (char c : chars_) {
+        set.set(static_cast<unsigned char>(c));
+      }
+      return set;
+    }
+
+    // ASCII only, same as the "C" locale
+    constexpr byte_set named_byte_set(std::string_view name_) {
+      byte_set set{};
+      if (name_ == "s" || name_ == "space") {
+        set = make_byte_set(" \t\n\v\f\r");
+      }
+      else if (name_ == "d" || name_ == "digit") {
+        set.set('0', '9');
+      }
+      else if (name_ == "upper") {
+        set.set('A', 'Z');
+      }
+      else if (name_ == "lower") {
+        set.set('a', 'z');
+      }
+      else if (name_ == "alpha" || name_ == "alnum" || name_ == "w") {
+        set.set('A', 'Z');
+        set.set('a', 'z');
+        if (name_ != "alpha") {
+          set.set('0', '9');
+        }
+        if (name_ == "w") {
+          set.set('_');
+        }
+      }
+      else if (name_ == "punct") {
+        set.set('!', '/');
+        set.set(':', '@');
+        set.set('[', '`');
+        set.set('{', '~');
+      }
+      else {
+        throw std::runtime_error{"Unknown character class in pattern"};
+      }
+      return set;
+    }
+
+    enum class repeat : unsigned char {once, optional, any};
+
+    struct pattern_item {
+      byte_set bytes{};
+      repeat count{repeat::once};
+    };
+
+    // a parsed pattern: items are matched one after the other
+    struct pattern_items {
+      static constexpr std::size_t max_size{63}; // positions, including the accepting one, must fit in 64 bits
+
+      constexpr void push_back(const byte_set& bytes_, repeat count_) {
+        if (size == max_size) {
+          throw std::runtime_error{"Pattern is too long"};
+        }
+        items[size++] = pattern_item{bytes_, count_};
+      }
+
+      std::array<pattern_item, max_size> items{};
+      std::size_t size{0};
+    };
+
+    // parses the escape sequence after a '\' at @pos_, returns the position after it
+    constexpr std::size_t parse_escape(std::string_view pattern_, std::size_t pos_, byte_set& bytes_) {
+      if (pos_ == pattern_.size()) {
+        throw std::runtime_error{"Pattern ends with an escape character"};
+      }
+
+      const char c = pattern_[pos_];
+      switch (c) {
+        case 's': case 'd': case 'w':
+          bytes_.set(named_byte_set(std::string_view{&c, 1}));
+          break;
+        case 'S': case 'D': case 'W': {
+          const char lower = static_cast<char>(c - 'A' + 'a');
+          auto negated = named_byte_set(std::string_view{&lower, 1});
+          negated.flip();
+          bytes_.set(negated);
+          break;
+        }
+        case 't': bytes_.set('\t'); break;
+        case 'n': bytes_.set('\n'); break;
+        case 'r': bytes_.set('\r'); break;
+        case 'f': bytes_.set('\f'); break;
+        case 'v': bytes_.set('\v'); break;
+        default:
+          if (c >= '0' && c <= '9') {
+            throw std::runtime_error{"Backreferences are not supported in pattern, see tag_pattern"};
+          }
+          bytes_.set(static_cast<unsigned char>(c));
+      }
+      return pos_ + 1;
+    }
+
+    // parses the bracket expression after a '[' at @pos_, returns the position after the closing ']'
+    constexpr std::size_t parse_bracket(std::string_view pattern_, std::size_t pos_, byte_set& bytes_) {
+      byte_set set{};
+      const bool negate = (pos_ < pattern_.size() && pattern_[pos_] == '^');
+      pos_ += negate;
+
+      while (pos_ < pattern_.size() && pattern_[pos_] != ']') {
+        if (pattern_.substr(pos_, 2) == "[:") {
+          const auto end = pattern_.find(":]", pos_ + 2);
+          if (end == std::string_view::npos) {
+            throw std::runtime_error{"Unterminated character class in pattern"};
+          }
+          set.set(named_byte_set(pattern_.substr(pos_ + 2, end - pos_ - 2)));
+          pos_ = end + 2;
+          continue;
+        }
+
+        if (pattern_[pos_] == '\\') {
+          pos_ = parse_escape(pattern_, pos_ + 1, set);
+          continue;
+        }
+
+        const auto first = static_cast<unsigned char>(pattern_[pos_++]);
+        if (pos_ + 1 < pattern_.size() && pattern_[pos_] == '-' && pattern_[pos_ + 1] != ']') {
+          const auto last = static_cast<unsigned char>(pattern_[pos_ + 1]);
+          if (last < first) {
+            throw std::runtime_error{"Invalid range in pattern"};
+          }
+          set.set(first, last);
+          pos_ += 2;
+        }
+        else {
+          set.set(first);
+        }
+      }
+
+      if (pos_ == pattern_.size()) {
+        throw std::runtime_error{"Unterminated bracket expression in pattern"};
+      }
+      if (negate) {
+        set.flip();
+      }
+      bytes_.set(set);
+      return pos_ + 1;
+    }
+
+    constexpr pattern_items parse_pattern(std::string_view pattern_) {
+      pattern_items items{};
+      std::size_t pos{0};
+      while (pos < pattern_.size()) {
+        byte_set bytes{};
+        const char c = pattern_[pos++];
+        switch (c) {
+          case '[':
+            pos = parse_bracket(pattern_, pos, bytes);
+            break;
+          case '\\':
+            pos = parse_escape(pattern_, pos, bytes);
+            break;
+          case '.':
+            bytes = make_byte_set("\n\r");
+            bytes.flip();
+            break;
+          case '*': case '+': case '?':
+            throw std::runtime_error{"Nothing to repeat in pattern"};
+          case '(': case ')': case '|': case '{': case '}': case '^': case '$':
+            throw std::runtime_error{"Unsupported syntax in pattern"};
+          default:
+            bytes.set(static_cast<unsigned char>(c));
+        }
+
+        const char quantifier = (pos < pattern_.size()) ? pattern_[pos] : '\0';
+        if (quantifier == '*') {
+          items.push_back(bytes, repeat::any);
+          ++pos;
+        }
+        else if (quantifier == '?') {
+          items.push_back(bytes, repeat::optional);
+          ++pos;
+        }
+        else if (quantifier == '+') {
+          items.push_back(bytes, repeat::once); // x+ is x x*
+          items.push_back(bytes, repeat::any);
+          ++pos;
+        }
+        else {
+          items.push_back(bytes, repeat::once);
+        }
+      }
+      return items;
+    }
+
+    // NFA states are the set of positions in the items, bit i meaning item i is next to be matched
+    // and bit 'size' meaning all of them have been matched
+
+    constexpr std::uint64_t nfa_closure(const pattern_items& items_, std::uint64_t states_) noexcept {
+      for (std::size_t i = 0; i < items_.size; ++i) {
+        if ((states_ >> i) & 1 && items_.items[i].count != repeat::once) {
+          states_ |= std::uint64_t{1} << (i + 1);
+        }
+      }
+      return states_;
+    }
+
+    constexpr std::uint64_t nfa_step(const pattern_items& items_, std::uint64_t states_, unsigned char c_) noexcept {
+      std::uint64_t next{0};
+      for (std::size_t i = 0; i < items_.size; ++i) {
+        if ((states_ >> i) & 1 && items_.items[i].bytes.test(c_)) {
+          next |= std::uint64_t{1} << (items_.items[i].count == repeat::any ? i : i + 1);
+        }
+      }
+      return nfa_closure(items_, next);
+    }
+  }
+
+  template <std::size_t MaxStates = 16>
+  class pattern {
+    static_assert(MaxStates >= 2 && MaxStates <= 256, "DFA states are stored in a byte");
+
+    using state_t = std::uint8_t;
+    static constexpr state_t dead_state{0};
+    static constexpr state_t start_state{1};
+
+  public:
+
+    class token_iterator;
+
+    // text between the matches, same as std::sregex_token_iterator with submatch -1:
+    // includes the empty tokens, except a trailing one (an empty text is a single empty token)
+    class token_range {
+    public:
+      constexpr token_range(const pattern* pattern_, std::string_view source_) noexcept : _pattern(pattern_), _source(source_) {}
+
+      token_iterator begin() const noexcept {
+        return token_iterator{_pattern, _source};
+      }
+
+      token_iterator end() const noexcept {
+        return token_iterator{};
+      }
+
+      std::vector<std::string_view> to_vector() const {
+        return std::vector<std::string_view>(begin(), end());
+      }
+
+    private:
+      const pattern* _pattern;
+      std::string_view _source;
+    };
+
+    // stashing, as tokenizer::iterator: *itr refers to the token kept in the iterator, hence not a forward iterator
+    class token_iterator {
+    public:
+      using iterator_category = std::input_iterator_tag;
+      using value_type = std::string_view;
+      using difference_type = std::ptrdiff_t;
+      using reference = const std::string_view&;
+      using pointer = const std::string_view*;
+
+      token_iterator() noexcept = default;
+
+      token_iterator(const pattern* pattern_, std::string_view source_) noexcept : _pattern(pattern_), _source(source_) {
+        advance();
+      }
+
+      reference operator*() const noexcept {
+        return _token;
+      }
+
+      pointer operator->() const noexcept {
+        return &_token;
+      }
+
+      token_iterator& operator++() noexcept {
+        advance();
+        return *this;
+      }
+
+      token_iterator operator++(int) noexcept {
+        auto copy = *this;
+        advance();
+        return copy;
+      }
+
+      bool operator==(const token_iterator& other_) const noexcept {
+        return _pattern == other_._pattern && _pos == other_._pos;
+      }
+
+      bool operator!=(const token_iterator& other_) const noexcept {
+        return !(*this == other_);
+      }
+
+    private:
+      void advance() noexcept {
+        if (_pattern == nullptr || _pos > _source.size()) {
+          *this = token_iterator{};
+          return;
+        }
+
+        // empty matches don't separate anything
+        if (const auto match = _pattern->find(_source, _pos, 1)) {
+          _token = _source.substr(_pos, match.position() - _pos);
+          _pos = match.position() + match.str().size();
+        }
+        else if (_pos < _source.size() || _pos == 0) {
+          _token = _source.substr(_pos);
+          _pos = _source.size() + 1;
+        }
+        else {
+          *this = token_iterator{};
+        }
+      }
+
+      const pattern* _pattern{nullptr};
+      std::string_view _source{};
+      std::string_view _token{};
+      std::size_t _pos{0};
+    };
+
+    explicit constexpr pattern(std::string_view pattern_) {
+      build(detail::parse_pattern(pattern_));
+    }
+
+    // true if whole of @text_ matches
+    constexpr bool match(std::string_view text_) const noexcept {
+      state_t state{start_state};
+      for (std::size_t i = 0; i < text_.size() && state != dead_state; ++i) {
+        state = _transitions[state][static_cast<unsigned char>(text_[i])];
+      }
+      return _accepting[state];
+    }
+
+    // leftmost-longest match at or after @from_
+    constexpr match_results<0> search(std::string_view text_, std::size_t from_ = 0) const noexcept {
+      return find(text_, from_, 0);
+    }
+
+    token_range split(std::string_view text_) const noexcept {
+      return token_range{this, text_};
+    }
+
+    // number of DFA states, including the dead state
+    constexpr std::size_t state_count() const noexcept {
+      return _stateCount;
+    }
+
+  private:
+
+    // subset construction, states are numbered in the order of discovery
+    constexpr void build(const detail::pattern_items& items_) {
+      std::array<std::uint64_t, MaxStates> nfa_states{};
+      nfa_states[start_state] = detail::nfa_closure(items_, 1);
+      _stateCount = 2;
+
+      for (std::size_t state = start_state; state < _stateCount; ++state) {
+        _accepting[state] = (nfa_states[state] >> items_.size) & 1;
+
+        for (unsigned c = 0; c < 256; ++c) {
+          const auto next = detail::nfa_step(items_, nfa_states[state], static_cast<unsigned char>(c));
+          std::size_t target{dead_state};
+          if (next != 0) {
+            for (target = start_state; target < _stateCount && nfa_states[target] != next; ++target) {}
+            if (target == _stateCount) {
+              if (_stateCount == MaxStates) {
+                throw std::runtime_error{"Pattern needs more DFA states than MaxStates"};
+              }
+              nfa_states[_stateCount++] = next;
+            }
+          }
+          _transitions[state][c] = static_cast<state_t>(target);
+        }
+      }
+
+      for (unsigned c = 0; c < 256; ++c) {
+        if (_transitions[start_state][c] != dead_state) {
+          _first.set(static_cast<unsigned char>(c));
+        }
+      }
+    }
+
+    // length of the longest match (at least @min_length_ long) starting at @pos_, npos if there is none
+    constexpr std::size_t longest_match(std::string_view text_, std::size_t pos_, std::size_t min_length_) const noexcept {
+      std::size_t longest = (min_length_ == 0 && _accepting[start_state]) ? 0 : std::string_view::npos;
+      state_t state{start_state};
+      for (auto i = pos_; i < text_.size(); ++i) {
+        state = _transitions[state][static_cast<unsigned char>(text_[i])];
+        if (state == dead_state) {
+          break;
+        }
+        if (_accepting[state]) {
+          longest = i + 1 - pos_;
+        }
+      }
+      return longest;
+    }
+
+    constexpr match_results<0> find(std::string_view text_, std::size_t from_, std::size_t min_length_) const noexcept {
+      const bool empty_matches = (min_length_ == 0 && _accepting[start_state]);
+      for (auto pos = from_; pos <= text_.size(); ++pos) {
+        // only bytes that can start a match are worth running the DFA from
+        if (!empty_matches && (pos == text_.size() || !_first.test(static_cast<unsigned char>(text_[pos])))) {
+          continue;
+        }
+        if (const auto length = longest_match(text_, pos, min_length_); length != std::string_view::npos) {
+          return match_results<0>{text_, {text_.substr(pos, length)}};
+        }
+      }
+      return match_results<0>{};
+    }
+
+    std::array<std::array<state_t, 256>, MaxStates> _transitions{};
+    std::array<bool, MaxStates> _accepting{};
+    detail::byte_set _first{};
+    std::size_t _stateCount{0};
+  };
+
+  /**
+   * Matcher for "<(.*)>(.*)<(\1)>" with configurable delimiters:
+   * group 1 is the tag, group 2 the value and group 3 the closing tag (same as group 1)
+   * As with std::regex, '.' doesn't match line terminators, and of all the possible matches at the
+   * leftmost position, the one with the longest tag and then the longest value is chosen
+   */
+  class tag_pattern {
+  public:
+    explicit constexpr tag_pattern(char open_ = '<', char close_ = '>') noexcept : _open(open_), _close(close_) {}
+
+    // whole of @text_ must match
+    constexpr match_results<3> match(std::string_view text_) const noexcept {
+      if (text_.size() < 4 || text_.front() != _open || text_.back() != _close || text_.find_first_of("\n\r") != std::string_view::npos) {
+        return match_results<3>{};
+      }
+
+      const auto size = text_.size();
+      for (auto tag_size = (size - 4) / 2 + 1; tag_size-- > 0; ) {
+        if (text_[tag_size + 1] == _close && text_[size - tag_size - 2] == _open &&
+            text_.substr(1, tag_size) == text_.substr(size - tag_size - 1, tag_size)) {
+          return groups(text_, 0, tag_size, size - tag_size - 2);
+        }
+      }
+      return match_results<3>{};
+    }
+
+    // leftmost match
+    constexpr match_results<3> search(std::string_view text_) const noexcept {
+      for (auto begin = text_.find(_open); begin != std::string_view::npos; begin = text_.find(_open, begin + 1)) {
+        const auto line_end = std::min(text_.find_first_of("\n\r", begin), text_.size());
+
+        // longest tag first, i.e. the last closing delimiter on the line
+        for (auto close = line_end; close-- > begin + 1; ) {
+          if (text_[close] != _close) {
+            continue;
+          }
+          const auto tag_size = close - begin - 1;
+          const auto tag = text_.substr(begin + 1, tag_size);
+
+          // longest value first, i.e. the last closing tag on the line
+          for (auto end_tag = line_end - std::min(line_end, tag_size + 2) + 1; end_tag-- > close + 1; ) {
+            if (text_[end_tag] == _open && text_[end_tag + tag_size + 1] == _close && text_.substr(end_tag + 1, tag_size) == tag) {
+              return groups(text_, begin, tag_size, end_tag);
+            }
+          }
+        }
+      }
+      return match_results<3>{};
+    }
+
+  private:
+    // match starting at @begin_, with the closing tag starting at @end_tag_
+    static constexpr match_results<3> groups(std::string_view text_, std::size_t begin_, std::size_t tag_size_, std::size_t end_tag_) noexcept {
+      const auto value_begin = begin_ + tag_size_ + 2;
+      return match_results<3>{text_, {text_.substr(begin_, end_tag_ + tag_size_ + 2 - begin_),
+                                      text_.substr(begin_ + 1, tag_size_),
+                                      text_.substr(value_begin, end_tag_ - value_begin),
+                                      text_.substr(end_tag_ + 1, tag_size_)}};
+    }
+
+    char _open;
+    char _close;
+  };
+}
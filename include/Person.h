@@ -1,12 +1,15 @@
 #pragma once
 
 #include "Reflection.h"
+#include "StringPool.h"
 
 #include <string>
 #include <tuple>
 
 /**
  * This is to help in getting reflection
+ * Names repeat a lot across people, hence they are interned: a Person is just two pointers,
+ * and comparing people for equality compares the pointers, not the names
  */
 class Person
 {
@@ -18,8 +21,8 @@ public:
    * Need both FT and ST types as if char arrays are used, they might have different types:
    * e.g. in Person{"anil", "kumar"}, FT is: char const (&)[5] while ST is: char const (&)[6]
    * */
-  template <typename FT, typename ST, typename = std::enable_if_t<std::is_constructible_v<std::string, FT> &&
-    std::is_constructible_v<std::string, ST>>>
+  template <typename FT, typename ST, typename = std::enable_if_t<std::is_constructible_v<my::interned_string, FT> &&
+    std::is_constructible_v<my::interned_string, ST>>>
 
   explicit Person(FT&& fName_, ST&& sName_):
   _fName(std::forward<FT>(fName_)),
@@ -29,6 +32,11 @@ public:
   auto mut_reflect() { return std::tie(_fName, _sName); }
 
 private:
-  std::string _fName;
-  std::string _sName;
-};
\ No newline at end of file
+  my::interned_string _fName;
+  my::interned_string _sName;
+};
+
+namespace std {
+  template <>
+  struct hash<Person> : my::reflection_hash<Person> {};
+}
\ No newline at end of file
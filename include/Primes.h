@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+/**
+ * Compile time generation of prime tables of arbitrary size
+ * The idea is to sieve (odd numbers only) up to an upper bound of Nth prime
+ * so that the number of steps stays close to linear in N, which keeps
+ * tables of several thousand primes well within the default constexpr limits
+ */
+
+namespace my {
+
+  constexpr std::size_t log2_ceil(std::size_t num) noexcept {
+    std::size_t log{0};
+    for (std::size_t power = 1; power < num; power *= 2) {
+      ++log;
+    }
+    return log;
+  }
+
+  /**
+   * Nth prime is less than n * (ln(n) + ln(ln(n))) for n >= 6 (Rosser's theorem)
+   * log2 is always larger than ln, hence ceil of log2 gives a (slightly wider) integral bound
+   */
+  constexpr std::size_t nth_prime_upper_bound(std::size_t n) noexcept {
+    if (n < 6) {
+      return 13;
+    }
+    const auto log_n = log2_ceil(n);
+    return n * (log_n + log2_ceil(log_n));
+  }
+
+  template <std::size_t N>
+  constexpr std::array<std::size_t, N> make_prime_table() {
+    std::array<std::size_t, N> primes{};
+    if constexpr (N != 0) {
+      constexpr auto limit = nth_prime_upper_bound(N);
+
+      // composite[i] is for the odd number 2*i+1
+      std::array<bool, limit / 2 + 1> composite{};
+
+      primes[0] = 2;
+      std::size_t count{1};
+      for (std::size_t i = 1; count != N; ++i) {
+        if (composite[i]) {
+          continue;
+        }
+
+        const auto prime = 2 * i + 1;
+        primes[count++] = prime;
+        for (auto j = prime * prime / 2; j < composite.size(); j += prime) {
+          composite[j] = true;
+        }
+      }
+    }
+
+    return primes;
+  }
+}
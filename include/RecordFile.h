@@ -0,0 +1,330 @@
+#pragma once
+
+#include "RecordFormatter.h"
+#include "Reflection.h"
+#include "TupleUtil.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstddef>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define MY_RECORD_FILE_MMAP
+#endif
+
+/**
+ * Bulk loading and storing of reflectable records in text files, one record per line:
+ * each line is exactly what operator<< writes for the record (members separated by spaces), followed by '\n'.
+ * As with operator>>, members are whitespace separated tokens, hence strings can't contain spaces.
+ *
+ * Reading maps the whole file into memory (or block-reads it where mmap isn't available),
+ * splits it into chunks on line boundaries and parses the chunks in parallel via mut_reflect().
+ * Writing formats records into a large buffer and writes it out in batches.
+ */
+
+namespace my {
+
+  // read-only view of a whole file
+  class mapped_file {
+  public:
+    explicit mapped_file(const std::string& path_) {
+#if defined(MY_RECORD_FILE_MMAP)
+      const int fd = ::open(path_.c_str(), O_RDONLY);
+      if (fd < 0) {
+        throw std::runtime_error{"Unable to open file: " + path_};
+      }
+
+      struct stat info{};
+      if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        throw std::runtime_error{"Unable to stat file: " + path_};
+      }
+
+      _size = static_cast<std::size_t>(info.st_size);
+      if (_size != 0) {
+        void* data = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (data == MAP_FAILED) {
+          ::close(fd);
+          throw std::runtime_error{"Unable to map file: " + path_};
+        }
+        ::madvise(data, _size, MADV_SEQUENTIAL);
+        _data = static_cast<const char*>(data);
+      }
+      ::close(fd);
+#else
+      std::ifstream file{path_, std::ios::binary};
+      if (!file) {
+        throw std::runtime_error{"Unable to open file: " + path_};
+      }
+      constexpr std::size_t block_size{1 << 20};
+      for (std::size_t read = block_size; read == block_size; ) {
+        const auto offset = _buffer.size();
+        _buffer.resize(offset + block_size);
+        file.read(_buffer.data() + offset, block_size);
+        read = static_cast<std::size_t>(file.gcount());
+        _buffer.resize(offset + read);
+      }
+      _data = _buffer.data();
+      _size = _buffer.size();
+#endif
+    }
+
+    mapped_file(const mapped_file&) = delete;
+    mapped_file& operator=(const mapped_file&) = delete;
+
+    ~mapped_file() {
+#if defined(MY_RECORD_FILE_MMAP)
+      if (_data != nullptr) {
+        ::munmap(const_cast<char*>(_data), _size);
+      }
+#endif
+    }
+
+    std::string_view data() const noexcept {
+      return std::string_view{_data, _size};
+    }
+
+  private:
+    const char* _data{nullptr};
+    std::size_t _size{0};
+#if !defined(MY_RECORD_FILE_MMAP)
+    std::string _buffer{};
+#endif
+  };
+
+  namespace detail {
+
+    // whitespace separated tokens of a single line
+    class token_reader {
+    public:
+      explicit token_reader(std::string_view line_) noexcept : _line(line_) {}
+
+      std::string_view next() {
+        skip_whitespace();
+        const auto begin = _pos;
+        while (_pos < _line.size() && !is_whitespace(_line[_pos])) {
+          ++_pos;
+        }
+        if (begin == _pos) {
+          throw std::runtime_error{"Too few members in record: " + std::string{_line}};
+        }
+        return _line.substr(begin, _pos - begin);
+      }
+
+      void must_be_exhausted() {
+        skip_whitespace();
+        if (_pos != _line.size()) {
+          throw std::runtime_error{"Too many members in record: " + std::string{_line}};
+        }
+      }
+
+    private:
+      static bool is_whitespace(char c) noexcept {
+        return c == ' ' || c == '\t' || c == '\r';
+      }
+
+      void skip_whitespace() noexcept {
+        while (_pos < _line.size() && is_whitespace(_line[_pos])) {
+          ++_pos;
+        }
+      }
+
+      std::string_view _line;
+      std::size_t _pos{0};
+    };
+
+    template <typename T>
+    void parse_member(token_reader& reader_, T& member_) {
+      if constexpr (is_mut_reflectable_v<T>) {
+        tuple_for_each(member_.mut_reflect(), [&reader_](auto& elem_) { parse_member(reader_, elem_); });
+      }
+      else if constexpr (std::is_same_v<T, std::string>) {
+        member_.assign(reader_.next());
+      }
+      else if constexpr (std::is_constructible_v<T, std::string_view>) {
+        member_ = T{reader_.next()}; // other string types, e.g. my::interned_string
+      }
+      else if constexpr (std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char>) {
+        const auto token = reader_.next();
+        if (token.size() != 1) {
+          throw std::runtime_error{"Invalid character member: " + std::string{token}};
+        }
+        member_ = static_cast<T>(token.front());
+      }
+      else if constexpr (std::is_same_v<T, bool>) {
+        int value{};
+        parse_member(reader_, value);
+        member_ = (value != 0);
+      }
+      else if constexpr (std::is_arithmetic_v<T>) {
+        const auto token = reader_.next();
+        const auto result = std::from_chars(token.data(), token.data() + token.size(), member_);
+        if (result.ec != std::errc{} || result.ptr != token.data() + token.size()) {
+          throw std::runtime_error{"Invalid numeric member: " + std::string{token}};
+        }
+      }
+      else {
+        static_assert(is_mut_reflectable_v<T>, "Member must either be arithmetic, a string or expose mut_reflect()");
+      }
+    }
+
+    template <typename T>
+    void parse_chunk(std::string_view chunk_, std::vector<T>& records_) {
+      while (!chunk_.empty()) {
+        const auto end = std::min(chunk_.find('\n'), chunk_.size());
+        const auto line = chunk_.substr(0, end);
+        chunk_.remove_prefix(std::min(end + 1, chunk_.size()));
+
+        if (line.find_first_not_of(" \t\r") == std::string_view::npos) {
+          continue; // blank line
+        }
+
+        token_reader reader{line};
+        T record{};
+        parse_member(reader, record);
+        reader.must_be_exhausted();
+        records_.push_back(std::move(record));
+      }
+    }
+  }
+
+  // splits @text_ into (at most) @count_ chunks of similar sizes, each of them ending at the end of a line
+  inline std::vector<std::string_view> split_lines(std::string_view text_, std::size_t count_) {
+    std::vector<std::string_view> chunks{};
+    std::size_t begin{0};
+    for (std::size_t i = 1; i <= count_ && begin < text_.size(); ++i) {
+      auto end = text_.size();
+      if (i != count_) {
+        const auto newline = text_.find('\n', std::max(begin, text_.size() / count_ * i));
+        end = (newline == std::string_view::npos) ? text_.size() : newline + 1;
+      }
+      chunks.push_back(text_.substr(begin, end - begin));
+      begin = end;
+    }
+    return chunks;
+  }
+
+  /**
+   * Parses all the records in @text_, on @threads_ threads (0 means one per hardware thread)
+   * Records are returned in the order of the text, throws std::runtime_error on malformed records
+   */
+  template <typename T>
+  std::vector<T> parse_records(std::string_view text_, std::size_t threads_ = 0) {
+    if (threads_ == 0) {
+      threads_ = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    const auto chunks = split_lines(text_, threads_);
+    std::vector<std::vector<T>> parsed(chunks.size());
+
+    // first chunk is parsed by the calling thread, rest of them in parallel
+    std::vector<std::future<void>> futures{};
+    for (std::size_t i = 1; i < chunks.size(); ++i) {
+      futures.push_back(std::async(std::launch::async, [&chunks, &parsed, i] { detail::parse_chunk(chunks[i], parsed[i]); }));
+    }
+    if (!chunks.empty()) {
+      detail::parse_chunk(chunks.front(), parsed.front());
+    }
+    for (auto& future : futures) {
+      future.get(); // rethrows parsing errors
+    }
+
+    if (parsed.size() == 1) {
+      return std::move(parsed.front());
+    }
+
+    std::size_t total{0};
+    for (const auto& records : parsed) {
+      total += records.size();
+    }
+
+    std::vector<T> records{};
+    records.reserve(total);
+    for (auto& chunk_records : parsed) {
+      std::move(chunk_records.begin(), chunk_records.end(), std::back_inserter(records));
+    }
+    return records;
+  }
+
+  template <typename T>
+  std::vector<T> read_record_file(const std::string& path_, std::size_t threads_ = 0) {
+    const mapped_file file{path_};
+    return parse_records<T>(file.data(), threads_);
+  }
+
+  // writes records, one per line, in batches of (roughly) @batch_size_ bytes
+  // throws std::runtime_error if a batch can't be written (e.g. the disk is full), except from the destructor:
+  // call flush() before destroying the writer to find out whether the last batch made it
+  template <typename T>
+  class record_file_writer {
+  public:
+
+    static constexpr std::size_t default_batch_size{1 << 20};
+
+    explicit record_file_writer(const std::string& path_, std::size_t batch_size_ = default_batch_size) :
+    _path(path_),
+    _file(path_, std::ios::binary | std::ios::trunc),
+    _batchSize(batch_size_) {
+      if (!_file) {
+        throw std::runtime_error{"Unable to open file: " + path_};
+      }
+      _buffer.reserve(_batchSize + 256);
+    }
+
+    ~record_file_writer() {
+      try {
+        flush();
+      }
+      catch (const std::runtime_error&) {
+        // can't throw from here
+      }
+    }
+
+    record_file_writer& write(const T& record_) {
+      record_formatter::append_record(_buffer, record_);
+      _buffer += '\n';
+      if (_buffer.size() >= _batchSize) {
+        flush();
+      }
+      return *this;
+    }
+
+    template <typename Itr>
+    record_file_writer& write(Itr begin_, Itr end_) {
+      for (; begin_ != end_; ++begin_) {
+        write(*begin_);
+      }
+      return *this;
+    }
+
+    void flush() {
+      if (!_buffer.empty()) {
+        _file.write(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+        _buffer.clear();
+      }
+      if (!_file.flush()) {
+        throw std::runtime_error{"Unable to write file: " + _path};
+      }
+    }
+
+  private:
+    std::string _path;
+    std::ofstream _file;
+    std::size_t _batchSize;
+    std::string _buffer{};
+  };
+}
@@ -1,8 +1,16 @@
 #pragma once
 
 #include "TupleUtil.h"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <ostream>
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
 /**
  * The idea is to test whether type T has reflect() member or not
@@ -36,17 +44,195 @@ using reflect_member_func = decltype(&T::reflect);
 template <typename T>
 using mut_reflect_member_func = decltype(&T::mut_reflect);
 
+/**
+ * Optional ordering hint: if a type exposes compare_reflect(), comparisons (==, !=, <, <=, >, >=)
+ * use the tuple it returns instead of reflect(). This lets cheap members (integers, string lengths)
+ * be compared before the expensive ones (string contents), e.g.
+ *
+ *   auto compare_reflect() const { return std::make_tuple(_name.size(), std::cref(_name)); }
+ *
+ * Note that for <, this defines a different (yet consistent) order than reflect() would
+ */
+template <typename T>
+using compare_reflect_member_func = decltype(&T::compare_reflect);
+
+namespace my {
+
+  template <typename T, typename = void>
+  struct is_reflectable : std::false_type {};
+
+  template <typename T>
+  struct is_reflectable<T, std::void_t<reflect_member_func<T>>> : std::true_type {};
+
+  template <typename T>
+  constexpr bool is_reflectable_v = is_reflectable<T>::value;
+
+  template <typename T, typename = void>
+  struct is_mut_reflectable : std::false_type {};
+
+  template <typename T>
+  struct is_mut_reflectable<T, std::void_t<mut_reflect_member_func<T>>> : std::true_type {};
+
+  template <typename T>
+  constexpr bool is_mut_reflectable_v = is_mut_reflectable<T>::value;
+
+  template <typename T, typename = void>
+  struct has_compare_reflect : std::false_type {};
+
+  template <typename T>
+  struct has_compare_reflect<T, std::void_t<compare_reflect_member_func<T>>> : std::true_type {};
+
+  template <typename T>
+  constexpr bool has_compare_reflect_v = has_compare_reflect<T>::value;
+
+  template <typename T, typename = std::void_t<reflect_member_func<T>>>
+  int compare(const T& left_, const T& right_);
+
+  namespace detail {
+    template <typename T>
+    auto compare_members(const T& obj_) {
+      if constexpr (has_compare_reflect_v<T>) {
+        return obj_.compare_reflect();
+      }
+      else {
+        return obj_.reflect();
+      }
+    }
+
+    // just the standard strings, other types convertible to std::string_view (e.g. my::interned_string)
+    // may compare equal by something other than their contents, and their operator< agrees with their operator==
+    template <typename T>
+    struct is_std_string : std::false_type {};
+
+    template <typename Char, typename Traits, typename Allocator>
+    struct is_std_string<std::basic_string<Char, Traits, Allocator>> : std::true_type {};
+
+    template <typename Char, typename Traits>
+    struct is_std_string<std::basic_string_view<Char, Traits>> : std::true_type {};
+
+    // three-way comparison of a single member, each member is compared only once
+    template <typename T>
+    int compare_member(const T& left_, const T& right_) {
+      if constexpr (is_reflectable_v<T>) {
+        return my::compare(left_, right_);
+      }
+      else if constexpr (is_std_string<T>::value) {
+        const auto result = left_.compare(right_);
+        return (result > 0) - (result < 0);
+      }
+      else {
+        return (right_ < left_) - (left_ < right_);
+      }
+    }
+
+    // stops at the first member which differs (short-circuiting fold over &&)
+    template <typename Tuple, std::size_t... Indices>
+    int compare_tuples(const Tuple& left_, const Tuple& right_, std::index_sequence<Indices...>) {
+      int result{0};
+      (((result = compare_member(std::get<Indices>(left_), std::get<Indices>(right_))) == 0) && ...);
+      return result;
+    }
+
+    template <typename Tuple>
+    int compare_tuples(const Tuple& left_, const Tuple& right_) {
+      return compare_tuples(left_, right_, std::make_index_sequence<std::tuple_size_v<Tuple>>{});
+    }
+  }
+
+  /**
+   * Three-way comparison derived from reflect() (or compare_reflect(), if present):
+   * negative if @left_ is less than @right_, 0 if they are equal, positive otherwise
+   */
+  template <typename T, typename>
+  int compare(const T& left_, const T& right_) {
+    return detail::compare_tuples(detail::compare_members(left_), detail::compare_members(right_));
+  }
+
+  namespace detail {
+    // secrets and multiply-fold (mum) mixer of wyhash
+    constexpr std::uint64_t hash_secret0{0xa0761d6478bd642full};
+    constexpr std::uint64_t hash_secret1{0xe7037ed1a0b428dbull};
+
+    inline std::uint64_t hash_mix(std::uint64_t left, std::uint64_t right) noexcept {
+#if defined(__SIZEOF_INT128__)
+      const auto product = static_cast<unsigned __int128>(left) * right;
+      return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#else
+      // splitmix64 finalizer, when there is no 128 bit multiplication
+      auto mixed = (left ^ (right + 0x9e3779b97f4a7c15ull));
+      mixed = (mixed ^ (mixed >> 30)) * 0xbf58476d1ce4e5b9ull;
+      mixed = (mixed ^ (mixed >> 27)) * 0x94d049bb133111ebull;
+      return mixed ^ (mixed >> 31);
+#endif
+    }
+
+    inline std::uint64_t hash_combine(std::uint64_t seed, std::uint64_t value) noexcept {
+      return hash_mix(seed ^ hash_secret0, value ^ hash_secret1);
+    }
+  }
+
+  /**
+   * Hash of a reflectable type: hashes of all the members (recursively for reflectable members,
+   * std::hash for the rest) are folded together with wyhash's mixer, in reflect() order.
+   * Weak member hashes (e.g. identity hash of integers in libstdc++) are mixed thoroughly as well,
+   * hence all the bits of result are usable, even by power-of-two sized tables
+   *
+   * std::hash can't be specialized for all reflectable types at once, so each type opts in with:
+   *   template <> struct std::hash<Type> : my::reflection_hash<Type> {};
+   */
+  template <typename T, typename = std::void_t<reflect_member_func<T>>>
+  struct reflection_hash {
+    std::size_t operator()(const T& obj_) const {
+      std::uint64_t seed{detail::hash_secret1};
+      tuple_for_each(obj_.reflect(), [&seed](const auto& elem_) {
+        using elem_t = std::decay_t<decltype(elem_)>;
+        if constexpr (is_reflectable_v<elem_t>) {
+          seed = detail::hash_combine(seed, reflection_hash<elem_t>{}(elem_));
+        }
+        else {
+          seed = detail::hash_combine(seed, std::hash<elem_t>{}(elem_));
+        }
+      });
+      return static_cast<std::size_t>(seed);
+    }
+  };
+}
+
 
 template <typename T, typename = std::void_t<reflect_member_func<T>>>
 auto operator== (const T& left_, const T& right_) -> bool
 {
-  return left_.reflect() == right_.reflect();
+  return my::detail::compare_members(left_) == my::detail::compare_members(right_);
 }
 
 template <typename T, typename = std::void_t<reflect_member_func <T>>>
 auto operator!= (const T& left_, const T& right_) -> bool
 {
-  return left_.reflect() != right_.reflect();
+  return !(left_ == right_);
+}
+
+template <typename T, typename = std::void_t<reflect_member_func<T>>>
+auto operator< (const T& left_, const T& right_) -> bool
+{
+  return my::compare(left_, right_) < 0;
+}
+
+template <typename T, typename = std::void_t<reflect_member_func<T>>>
+auto operator<= (const T& left_, const T& right_) -> bool
+{
+  return my::compare(left_, right_) <= 0;
+}
+
+template <typename T, typename = std::void_t<reflect_member_func<T>>>
+auto operator> (const T& left_, const T& right_) -> bool
+{
+  return my::compare(left_, right_) > 0;
+}
+
+template <typename T, typename = std::void_t<reflect_member_func<T>>>
+auto operator>= (const T& left_, const T& right_) -> bool
+{
+  return my::compare(left_, right_) >= 0;
 }
 
 template <typename T, typename = std::void_t <reflect_member_func <T>>>
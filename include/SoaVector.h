@@ -0,0 +1,205 @@
+#pragma once
+
+#include "Reflection.h"
+#include "TupleUtil.h"
+#include "algorithm.h"
+
+#include <cstddef>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * Columnar (structure-of-arrays) container for reflectable types:
+ * every member returned by reflect() is stored in its own contiguous column (std::vector),
+ * so a scan touching a single member only brings that member's column into cache,
+ * and arithmetic columns can be processed by vectorized loops.
+ *
+ * Elements are accessed through proxy references: tuples of references into the columns,
+ * in reflect() order, which also work with structured bindings:
+ *   for (auto [fName, sName] : people) {...}
+ */
+
+namespace my {
+
+  template <typename T>
+  class soa_vector {
+
+    static_assert(is_reflectable_v<T>, "soa_vector needs a type exposing reflect()");
+
+    template <typename Tuple>
+    struct traits;
+
+    template <typename... Members>
+    struct traits<std::tuple<Members...>> {
+      static_assert(sizeof...(Members) > 0, "soa_vector needs a type with at least one reflected member");
+      using columns = std::tuple<std::vector<std::decay_t<Members>>...>;
+      using reference = std::tuple<std::decay_t<Members>&...>;
+      using const_reference = std::tuple<const std::decay_t<Members>&...>;
+    };
+
+    using traits_t = traits<decltype(std::declval<const T&>().reflect())>;
+
+  public:
+    using value_type = T;
+    using columns_t = typename traits_t::columns;
+    using reference = typename traits_t::reference;
+    using const_reference = typename traits_t::const_reference;
+
+    static constexpr std::size_t column_count{std::tuple_size_v<columns_t>};
+
+    template <std::size_t Index>
+    using column_t = std::tuple_element_t<Index, columns_t>;
+
+    template <bool Const>
+    class iterator_t {
+    public:
+      using owner_t = std::conditional_t<Const, const soa_vector, soa_vector>;
+      using iterator_category = std::input_iterator_tag; // proxy references can't satisfy forward iterator
+      using value_type = T;
+      using difference_type = std::ptrdiff_t;
+      using reference = std::conditional_t<Const, const_reference, typename soa_vector::reference>;
+      using pointer = void;
+
+      iterator_t(owner_t* owner_, std::size_t index_) noexcept : _owner(owner_), _index(index_) {}
+
+      reference operator*() const {
+        return (*_owner)[_index];
+      }
+
+      iterator_t& operator++() noexcept {
+        ++_index;
+        return *this;
+      }
+
+      iterator_t operator++(int) noexcept {
+        auto copy = *this;
+        ++_index;
+        return copy;
+      }
+
+      difference_type operator-(const iterator_t& other_) const noexcept {
+        return static_cast<difference_type>(_index) - static_cast<difference_type>(other_._index);
+      }
+
+      bool operator==(const iterator_t& other_) const noexcept {
+        return _index == other_._index && _owner == other_._owner;
+      }
+
+      bool operator!=(const iterator_t& other_) const noexcept {
+        return !(*this == other_);
+      }
+
+    private:
+      owner_t* _owner;
+      std::size_t _index;
+    };
+
+    using iterator = iterator_t<false>;
+    using const_iterator = iterator_t<true>;
+
+    soa_vector() = default;
+
+    // scatters the reflected members of @obj_ to the columns
+    // if any of the columns throws, all of them are rolled back to the previous size
+    void push_back(const T& obj_) {
+      const auto old_size = size();
+      try {
+        tuple_for_each_indexed(obj_.reflect(), [this](auto index_, const auto& member_) {
+          std::get<decltype(index_)::value>(_columns).push_back(member_);
+        });
+      }
+      catch (...) {
+        tuple_for_each(_columns, [old_size](auto& column_) {
+          column_.erase(column_.begin() + std::min(old_size, column_.size()), column_.end());
+        });
+        throw;
+      }
+    }
+
+    // gathers the members back into an object, needs T to be default constructible and to expose mut_reflect()
+    T get(std::size_t index_) const {
+      static_assert(is_mut_reflectable_v<T>, "soa_vector::get needs a type exposing mut_reflect()");
+      T obj{};
+      obj.mut_reflect() = (*this)[index_];
+      return obj;
+    }
+
+    reference operator[](std::size_t index_) {
+      return std::apply([index_](auto&... columns_) { return reference{columns_[index_]...}; }, _columns);
+    }
+
+    const_reference operator[](std::size_t index_) const {
+      return std::apply([index_](const auto&... columns_) { return const_reference{columns_[index_]...}; }, _columns);
+    }
+
+    template <std::size_t Index>
+    column_t<Index>& column() noexcept {
+      return std::get<Index>(_columns);
+    }
+
+    template <std::size_t Index>
+    const column_t<Index>& column() const noexcept {
+      return std::get<Index>(_columns);
+    }
+
+    // scans only the column of member at @Index
+    template <std::size_t Index, typename Predicate>
+    std::size_t count_if(const Predicate& predicate_) const {
+      const auto& values = column<Index>();
+      return static_cast<std::size_t>(my::count_if(values.begin(), values.end(), predicate_));
+    }
+
+    // indices of all the elements whose member at @Index satisfies @predicate_
+    // written without a branch per element, so that the loop can be vectorized
+    template <std::size_t Index, typename Predicate>
+    std::vector<std::size_t> filter(const Predicate& predicate_) const {
+      const auto& values = column<Index>();
+      std::vector<std::size_t> indices(values.size());
+      std::size_t count{0};
+      for (std::size_t i = 0; i < values.size(); ++i) {
+        indices[count] = i;
+        count += static_cast<bool>(predicate_(values[i]));
+      }
+      indices.resize(count);
+      return indices;
+    }
+
+    void reserve(std::size_t capacity_) {
+      tuple_for_each(_columns, [capacity_](auto& column_) { column_.reserve(capacity_); });
+    }
+
+    void clear() noexcept {
+      tuple_for_each(_columns, [](auto& column_) { column_.clear(); });
+    }
+
+    std::size_t size() const noexcept {
+      return std::get<0>(_columns).size();
+    }
+
+    bool empty() const noexcept {
+      return size() == 0;
+    }
+
+    iterator begin() noexcept {
+      return iterator{this, 0};
+    }
+
+    iterator end() noexcept {
+      return iterator{this, size()};
+    }
+
+    const_iterator begin() const noexcept {
+      return const_iterator{this, 0};
+    }
+
+    const_iterator end() const noexcept {
+      return const_iterator{this, size()};
+    }
+
+  private:
+    columns_t _columns{};
+  };
+}
@@ -0,0 +1,179 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+
+/**
+ * Interning pool: every distinct string is stored once, and is referred to by an interned_string handle,
+ * a single pointer, hence equal strings (of the same pool) are equal handles, and comparing them for
+ * equality is a pointer compare
+ * Strings (and the nodes of the set indexing them) live in monotonic arenas, and are never freed until
+ * the pool itself is destroyed, so handles stay valid for the lifetime of the pool
+ * Pool is split into shards, each with its own lock and arena, picked by the hash of the string,
+ * so that threads interning different strings rarely contend
+ */
+
+namespace my {
+
+  class string_pool;
+
+  class interned_string {
+  public:
+    interned_string() noexcept = default;
+
+    // interned in string_pool::global()
+    explicit interned_string(std::string_view str_);
+
+    explicit interned_string(const char* str_) : interned_string(std::string_view{str_}) {}
+
+    explicit interned_string(const std::string& str_) : interned_string(std::string_view{str_}) {}
+
+    std::string_view view() const noexcept {
+      return *_view;
+    }
+
+    operator std::string_view() const noexcept {
+      return *_view;
+    }
+
+    const char* data() const noexcept {
+      return _view->data();
+    }
+
+    std::size_t size() const noexcept {
+      return _view->size();
+    }
+
+    bool empty() const noexcept {
+      return _view->empty();
+    }
+
+    // handles of different pools are never equal, even for the same contents
+    friend bool operator==(interned_string left_, interned_string right_) noexcept {
+      return left_._view == right_._view;
+    }
+
+    friend bool operator!=(interned_string left_, interned_string right_) noexcept {
+      return left_._view != right_._view;
+    }
+
+    // ordering is by contents, and by address among equal contents of different pools, so that
+    // handles neither of which is less than the other are equal handles, as for operator==
+    friend bool operator<(interned_string left_, interned_string right_) noexcept {
+      return *left_._view < *right_._view ||
+             (*left_._view == *right_._view && std::less<const std::string_view*>{}(left_._view, right_._view));
+    }
+
+    friend std::ostream& operator<<(std::ostream& os_, interned_string str_) {
+      return os_ << *str_._view;
+    }
+
+    friend std::istream& operator>>(std::istream& is_, interned_string& str_) {
+      std::string token{};
+      if (is_ >> token) {
+        str_ = interned_string{std::string_view{token}};
+      }
+      return is_;
+    }
+
+  private:
+    friend class string_pool;
+    friend struct std::hash<interned_string>;
+
+    explicit interned_string(const std::string_view* view_) noexcept : _view(view_) {}
+
+    // shared by all the pools, so that all the empty strings are equal
+    static constexpr std::string_view empty_view{};
+
+    const std::string_view* _view{&empty_view};
+  };
+
+  class string_pool {
+  public:
+    static constexpr std::size_t default_shard_count{16};
+
+    explicit string_pool(std::size_t shards_ = default_shard_count) :
+    _shardCount(std::max<std::size_t>(shards_, 1)),
+    _shards(std::make_unique<shard[]>(_shardCount)) {}
+
+    string_pool(const string_pool&) = delete;
+    string_pool& operator=(const string_pool&) = delete;
+
+    // pool behind the handles made from plain strings, lives until the end of the program
+    static string_pool& global() {
+      static string_pool pool{};
+      return pool;
+    }
+
+    // thread safe
+    interned_string intern(std::string_view str_) {
+      if (str_.empty()) {
+        return interned_string{};
+      }
+
+      auto& shard = _shards[std::hash<std::string_view>{}(str_) % _shardCount];
+      std::lock_guard<std::mutex> lock{shard.mutex};
+      auto itr = shard.strings.find(str_);
+      if (itr == shard.strings.end()) {
+        auto* chars = static_cast<char*>(shard.arena.allocate(str_.size(), 1));
+        std::memcpy(chars, str_.data(), str_.size());
+        itr = shard.strings.emplace(chars, str_.size()).first;
+        shard.bytes += str_.size();
+      }
+      return interned_string{&*itr}; // nodes of unordered_set never move
+    }
+
+    // number of distinct strings
+    std::size_t size() const {
+      std::size_t count{0};
+      for (std::size_t i = 0; i < _shardCount; ++i) {
+        std::lock_guard<std::mutex> lock{_shards[i].mutex};
+        count += _shards[i].strings.size();
+      }
+      return count;
+    }
+
+    // total length of the distinct strings
+    std::size_t bytes() const {
+      std::size_t count{0};
+      for (std::size_t i = 0; i < _shardCount; ++i) {
+        std::lock_guard<std::mutex> lock{_shards[i].mutex};
+        count += _shards[i].bytes;
+      }
+      return count;
+    }
+
+  private:
+    // on a cache line of its own, so that threads locking neighbouring shards don't slow each other down
+    struct alignas(64) shard {
+      mutable std::mutex mutex{};
+      std::pmr::monotonic_buffer_resource arena{};
+      std::pmr::unordered_set<std::string_view> strings{&arena};
+      std::size_t bytes{0};
+    };
+
+    std::size_t _shardCount;
+    std::unique_ptr<shard[]> _shards;
+  };
+
+  inline interned_string::interned_string(std::string_view str_) : interned_string(string_pool::global().intern(str_)) {}
+}
+
+namespace std {
+  template <>
+  struct hash<my::interned_string> {
+    std::size_t operator()(my::interned_string str_) const noexcept {
+      return std::hash<const void*>{}(str_._view);
+    }
+  };
+}
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * Fixed set of worker threads running parallel loops over independent indices.
+ * The calling thread works on the loop as well, and every thread (worker or caller) grabs
+ * the next index from a shared counter as soon as it's done with the previous one, so threads that
+ * got cheap indices take over the rest of the work instead of waiting for the ones with expensive indices.
+ * Loops don't allocate: the loop body is called through a plain function pointer.
+ */
+
+namespace my {
+
+  class thread_pool {
+  public:
+
+    // @threads_ includes the calling thread, hence a pool of 1 runs everything on the calling thread
+    explicit thread_pool(std::size_t threads_ = std::max(1u, std::thread::hardware_concurrency())) {
+      for (std::size_t i = 1; i < threads_; ++i) {
+        _workers.emplace_back([this] { work(); });
+      }
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    ~thread_pool() {
+      {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _stop = true;
+      }
+      _wakeUp.notify_all();
+      for (auto& worker : _workers) {
+        worker.join();
+      }
+    }
+
+    // including the calling thread
+    std::size_t size() const noexcept {
+      return _workers.size() + 1;
+    }
+
+    // calls @func_(i) for every i in [0, count_), in parallel, and returns once all of them are done
+    // if any of the calls throws, the rest of the indices are skipped, and the first exception is rethrown
+    template <typename Func>
+    void parallel_for(std::size_t count_, Func&& func_) {
+      using func_t = std::remove_reference_t<Func>;
+      std::lock_guard<std::mutex> submit{_submit}; // one loop at a time
+
+      {
+        std::lock_guard<std::mutex> lock{_mutex};
+        _count = count_;
+        _next = 0;
+        _context = const_cast<void*>(static_cast<const void*>(&func_));
+        _invoke = [](void* context_, std::size_t index_) { (*static_cast<func_t*>(context_))(index_); };
+        _error = nullptr;
+        _open = true;
+        ++_generation;
+      }
+      _wakeUp.notify_all();
+
+      run();
+
+      // workers still running the loop refer to @func_, which lives on this stack
+      std::unique_lock<std::mutex> lock{_mutex};
+      _open = false;
+      _finished.wait(lock, [this] { return _active == 0; });
+      if (_error) {
+        std::rethrow_exception(_error);
+      }
+    }
+
+  private:
+    void run() noexcept {
+      for (auto index = _next.fetch_add(1); index < _count; index = _next.fetch_add(1)) {
+        try {
+          _invoke(_context, index);
+        }
+        catch (...) {
+          std::lock_guard<std::mutex> lock{_mutex};
+          if (!_error) {
+            _error = std::current_exception();
+          }
+          _next = _count; // skip the rest of them
+        }
+      }
+    }
+
+    void work() {
+      std::size_t seen{0};
+      std::unique_lock<std::mutex> lock{_mutex};
+      while (true) {
+        _wakeUp.wait(lock, [this, seen] { return _stop || _generation != seen; });
+        if (_stop) {
+          return;
+        }
+        seen = _generation;
+        if (!_open) {
+          continue; // woke up too late, loop is already over
+        }
+
+        ++_active;
+        lock.unlock();
+        run();
+        lock.lock();
+        if (--_active == 0) {
+          _finished.notify_one();
+        }
+      }
+    }
+
+    std::vector<std::thread> _workers{};
+    std::mutex _submit{};
+
+    // current loop, guarded by _mutex (except for _next, which is what threads race for)
+    std::mutex _mutex{};
+    std::condition_variable _wakeUp{};
+    std::condition_variable _finished{};
+    std::size_t _count{0};
+    std::atomic<std::size_t> _next{0};
+    void* _context{nullptr};
+    void (*_invoke)(void*, std::size_t){nullptr};
+    std::exception_ptr _error{};
+    std::size_t _generation{0};
+    std::size_t _active{0};
+    bool _open{false};
+    bool _stop{false};
+  };
+}
@@ -0,0 +1,409 @@
+#pragma once
+
+#include "BinarySerialization.h"
+#include "LRUCache.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#define MY_TIERED_CACHE_MMAP
+#endif
+
+/**
+ * LRUCache with a second, much larger tier on disk:
+ * the least recently used entry of the memory tier isn't thrown away when the memory tier is full,
+ * it is spilled to the disk tier instead, and is promoted back to the memory tier on get().
+ * An entry is in exactly one of the tiers.
+ *
+ * The disk tier is a set of append-only segment files (<spillPath>.<n>), mapped into memory,
+ * with an in-memory index from key to the location of its (binary serialized) value.
+ * Promoting or erasing an entry leaves its bytes behind as garbage, and once the live bytes of a full
+ * (sealed) segment drop below the compaction ratio, a background thread moves the remaining entries
+ * to the active segment and removes the segment.
+ *
+ * Keys and values must be serializable by my::binary_writer (arithmetic, strings or reflectable types),
+ * and values must own their data (e.g. std::string, not std::string_view).
+ * Like LRUCache, it is not thread-safe, the background compaction is synchronized internally.
+ * Where mmap isn't available, segments are kept in the heap.
+ */
+
+namespace lru_detail {
+
+  // append-only buffer of serialized values, backed by a file mapped into memory
+  class spill_segment {
+  public:
+    spill_segment(std::string path_, std::size_t capacity_) : _path(std::move(path_)), _capacity(capacity_) {
+#if defined(MY_TIERED_CACHE_MMAP)
+      const int fd = ::open(_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+      if (fd < 0) {
+        throw std::runtime_error{"Unable to create spill file: " + _path};
+      }
+      if (::ftruncate(fd, static_cast<off_t>(_capacity)) != 0) {
+        ::close(fd);
+        ::unlink(_path.c_str());
+        throw std::runtime_error{"Unable to size spill file: " + _path};
+      }
+      void* data = ::mmap(nullptr, _capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      ::close(fd);
+      if (data == MAP_FAILED) {
+        ::unlink(_path.c_str());
+        throw std::runtime_error{"Unable to map spill file: " + _path};
+      }
+      _data = static_cast<char*>(data);
+#else
+      _buffer = std::make_unique<char[]>(_capacity);
+      _data = _buffer.get();
+#endif
+    }
+
+    spill_segment(const spill_segment&) = delete;
+    spill_segment& operator=(const spill_segment&) = delete;
+
+    // spilled values are of no use once the cache is gone
+    ~spill_segment() {
+#if defined(MY_TIERED_CACHE_MMAP)
+      ::munmap(_data, _capacity);
+      ::unlink(_path.c_str());
+#endif
+    }
+
+    // room for @size_ more bytes at the end, nullptr if the segment is full
+    char* append(std::size_t size_) noexcept {
+      if (size_ > _capacity - _size) {
+        return nullptr;
+      }
+      char* out = _data + _size;
+      _size += size_;
+      return out;
+    }
+
+    const char* data() const noexcept {
+      return _data;
+    }
+
+    std::size_t size() const noexcept {
+      return _size;
+    }
+
+  private:
+    std::string _path;
+    std::size_t _capacity;
+    std::size_t _size{0};
+    char* _data{nullptr};
+#if !defined(MY_TIERED_CACHE_MMAP)
+    std::unique_ptr<char[]> _buffer{};
+#endif
+  };
+
+  struct spill_location {
+    std::uint32_t segment;
+    std::uint32_t size;
+    std::uint64_t offset;
+
+    bool operator==(const spill_location& other_) const noexcept {
+      return segment == other_.segment && size == other_.size && offset == other_.offset;
+    }
+  };
+}
+
+template<typename Key, typename Value>
+class TieredLRUCache {
+public:
+
+  // aliases
+  using memory_tier = LRUCache<Key, Value>;
+  using iterator = typename memory_tier::iterator;
+
+  struct Stats {
+    std::size_t memoryHits{0};
+    std::size_t diskHits{0};
+    std::size_t misses{0};
+    std::size_t spills{0};
+    std::size_t compactions{0};
+    std::size_t diskEntries{0};
+    std::size_t segments{0};
+    std::size_t diskBytes{0};   // including garbage
+  };
+
+  static constexpr std::size_t defaultSegmentSize{64 << 20};
+
+  TieredLRUCache(std::size_t memorySize_, std::string spillPath_, std::size_t segmentSize_ = defaultSegmentSize,
+                 double compactionRatio_ = 0.5) :
+  _memory(memorySize_),
+  _spillPath(std::move(spillPath_)),
+  _segmentSize(segmentSize_),
+  _compactionRatio(compactionRatio_) {
+    if (memorySize_ == 0) {
+      throw std::runtime_error{"Memory tier must be able to hold at least one entry"};
+    }
+    _compactor = std::thread{[this] { compactInBackground(); }};
+  }
+
+  TieredLRUCache(const TieredLRUCache&) = delete;
+  TieredLRUCache& operator=(const TieredLRUCache&) = delete;
+
+  ~TieredLRUCache() {
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      _stop = true;
+    }
+    _compactionNeeded.notify_one();
+    _compactor.join();
+  }
+
+  // entries in both the tiers
+  std::size_t size() {
+    std::lock_guard<std::mutex> lock{_mutex};
+    return _memory.size() + _index.size();
+  }
+
+  // size of the memory tier
+  std::size_t maxSize() { return _memory.maxSize(); }
+
+  // if the key exists in either of the tiers, it is made most recently used key (of the memory tier)
+  iterator get(const Key &key) {
+    if (auto itr = _memory.get(key); itr != _memory.end()) {
+      ++_stats.memoryHits;
+      return itr;
+    }
+
+    auto itr = promote(key);
+    ++(itr != _memory.end() ? _stats.diskHits : _stats.misses);
+    return itr;
+  }
+
+  // same as LRUCache::insert, an existing key (in either of the tiers) isn't overwritten
+  iterator insert(const Key &key, const Value &value) {
+    if (auto itr = _memory.get(key); itr != _memory.end()) {
+      return itr;
+    }
+    if (auto itr = promote(key); itr != _memory.end()) {
+      return itr;
+    }
+
+    spillIfFull();
+    return _memory.insert(key, std::move(value));
+  }
+
+  void erase(const Key& key) {
+    _memory.erase(key);
+
+    std::lock_guard<std::mutex> lock{_mutex};
+    if (auto indexItr = _index.find(key); indexItr != _index.end()) {
+      release(indexItr->second);
+      _index.erase(indexItr);
+    }
+  }
+
+  // entries of the memory tier only, this doesn't alter the access order
+  iterator begin() {
+    return _memory.begin();
+  }
+
+  iterator end() {
+    return _memory.end();
+  }
+
+  Stats stats() {
+    std::lock_guard<std::mutex> lock{_mutex};
+    auto stats = _stats;
+    stats.compactions = _compactions;
+    stats.diskEntries = _index.size();
+    stats.segments = _segments.size();
+    stats.diskBytes = 0;
+    for (const auto& segment : _segments) {
+      stats.diskBytes += segment.second.data->size();
+    }
+    return stats;
+  }
+
+  // compacts all the sealed segments below the compaction ratio right away,
+  // instead of waiting for the background thread to do it
+  void compact() {
+    std::lock_guard<std::mutex> compacting{_compactionMutex}; // one compaction at a time, be it this one or the background one
+    std::vector<std::uint32_t> candidates{};
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      for (const auto& segment : _segments) {
+        if (needsCompaction(segment.first, segment.second)) {
+          candidates.push_back(segment.first);
+        }
+      }
+    }
+
+    for (auto id : candidates) {
+      compactSegment(id);
+    }
+  }
+
+private:
+
+  struct Segment {
+    std::unique_ptr<lru_detail::spill_segment> data;
+    std::size_t liveBytes{0};
+  };
+
+  // moves the entry from disk tier to the memory tier, end() if the key isn't on disk
+  iterator promote(const Key& key) {
+    Value value{};
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      auto indexItr = _index.find(key);
+      if (indexItr == _index.end()) {
+        return _memory.end();
+      }
+
+      const auto location = indexItr->second;
+      my::deserialize(value, _segments.at(location.segment).data->data() + location.offset, location.size);
+      release(location);
+      _index.erase(indexItr);
+    }
+
+    spillIfFull();
+    return _memory.insert(key, std::move(value));
+  }
+
+  // makes room in the memory tier by moving its least recently used entry to the disk tier
+  void spillIfFull() {
+    if (_memory.size() < _memory.maxSize()) {
+      return;
+    }
+
+    const auto victim = _memory.begin();
+    const auto size = my::binary_size(victim->second);
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      lru_detail::spill_location location{};
+      my::binary_writer{reserve(size, location), size}.write(victim->second);
+      _index.emplace(victim->first, location);
+      ++_stats.spills;
+    }
+    _memory.erase(victim->first);
+  }
+
+  // room for @size_ bytes at the end of the active segment (sealing it if it's full), must be called with the lock held
+  char* reserve(std::size_t size_, lru_detail::spill_location& location_) {
+    if (size_ > std::numeric_limits<std::uint32_t>::max()) {
+      throw std::runtime_error{"Value is too large to be spilled"};
+    }
+
+    char* out = _segments.empty() ? nullptr : _segments.at(_activeSegment).data->append(size_);
+    if (out == nullptr) {
+      const auto sealed = _activeSegment;
+      _activeSegment = _nextSegment++;
+      auto data = std::make_unique<lru_detail::spill_segment>(_spillPath + "." + std::to_string(_activeSegment), std::max(_segmentSize, size_));
+      out = data->append(size_);
+      _segments.emplace(_activeSegment, Segment{std::move(data)});
+
+      // release() doesn't compact the active segment, hence its garbage is only looked at once it's sealed
+      if (auto sealedItr = _segments.find(sealed); sealedItr != _segments.end() && needsCompaction(sealed, sealedItr->second)) {
+        _compactionPending = true;
+        _compactionNeeded.notify_one();
+      }
+    }
+
+    auto& active = _segments.at(_activeSegment);
+    active.liveBytes += size_;
+    location_ = lru_detail::spill_location{_activeSegment, static_cast<std::uint32_t>(size_),
+                                           static_cast<std::uint64_t>(out - active.data->data())};
+    return out;
+  }
+
+  // marks the bytes at @location_ as garbage, must be called with the lock held
+  void release(const lru_detail::spill_location& location_) {
+    auto& segment = _segments.at(location_.segment);
+    segment.liveBytes -= location_.size;
+    if (!_compactionPending && needsCompaction(location_.segment, segment)) {
+      _compactionPending = true;
+      _compactionNeeded.notify_one();
+    }
+  }
+
+  bool needsCompaction(std::uint32_t id_, const Segment& segment_) const noexcept {
+    return id_ != _activeSegment && segment_.liveBytes < _compactionRatio * segment_.data->size();
+  }
+
+  // moves the live entries of a sealed segment to the active one, and removes the segment
+  void compactSegment(std::uint32_t id_) {
+    std::vector<std::pair<Key, lru_detail::spill_location>> entries{};
+    {
+      std::lock_guard<std::mutex> lock{_mutex};
+      for (const auto& entry : _index) {
+        if (entry.second.segment == id_) {
+          entries.push_back(entry);
+        }
+      }
+    }
+
+    // entry by entry, so that get() isn't blocked for the whole compaction
+    for (const auto& entry : entries) {
+      std::lock_guard<std::mutex> lock{_mutex};
+      auto indexItr = _index.find(entry.first);
+      if (indexItr == _index.end() || !(indexItr->second == entry.second)) {
+        continue; // promoted or erased in the mean time
+      }
+
+      lru_detail::spill_location location{};
+      char* out = reserve(entry.second.size, location);
+      std::memcpy(out, _segments.at(id_).data->data() + entry.second.offset, entry.second.size);
+      _segments.at(id_).liveBytes -= entry.second.size; // not release(), it would ask for this very compaction again
+      indexItr->second = location;
+    }
+
+    std::lock_guard<std::mutex> lock{_mutex};
+    if (_segments.erase(id_) != 0) {
+      ++_compactions;
+    }
+  }
+
+  void compactInBackground() {
+    std::unique_lock<std::mutex> lock{_mutex};
+    while (true) {
+      _compactionNeeded.wait(lock, [this] { return _stop || _compactionPending; });
+      if (_stop) {
+        return;
+      }
+      _compactionPending = false;
+      lock.unlock();
+      compact();
+      lock.lock();
+    }
+  }
+
+  memory_tier _memory;
+  std::string _spillPath;
+  std::size_t _segmentSize;
+  double _compactionRatio;
+
+  // disk tier, guarded by _mutex as it's shared with the compaction thread
+  std::mutex _mutex{};
+  std::unordered_map<Key, lru_detail::spill_location> _index{};
+  std::unordered_map<std::uint32_t, Segment> _segments{};
+  std::uint32_t _activeSegment{0};
+  std::uint32_t _nextSegment{0};
+  Stats _stats{};
+  std::size_t _compactions{0};
+
+  // held for the whole of a compact(), before _mutex, which is only held entry by entry
+  std::mutex _compactionMutex{};
+  std::condition_variable _compactionNeeded{};
+  bool _compactionPending{false};
+  bool _stop{false};
+  std::thread _compactor{};
+};
@@ -0,0 +1,177 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * Splits a text into std::string_view tokens on a class of separator characters,
+ * without std::regex and without any allocation. Same as splitting with
+ * std::sregex_token_iterator over "[[:s:]]*[,;.:][[:s:]]*" and dropping empty tokens:
+ *  => whitespace around the separators is trimmed
+ *  => empty tokens (e.g. due to leading, trailing or consecutive separators) are skipped
+ * Unlike the regex, whitespace at the very beginning and end of the text is trimmed as well
+ *
+ * Separators are searched 16 bytes at a time with SSE2 (when available, for up to 16 separators)
+ * and through a 256 entry byte class table otherwise
+ */
+
+namespace my {
+
+  class tokenizer {
+  public:
+
+    static constexpr std::string_view default_separators{",;.:"};
+    static constexpr std::size_t max_simd_separators{16};
+
+    // stashing: *itr refers to the token kept in the iterator, hence not a forward iterator
+    // (equal iterators don't yield the same object)
+    class iterator {
+    public:
+      using iterator_category = std::input_iterator_tag;
+      using value_type = std::string_view;
+      using difference_type = std::ptrdiff_t;
+      using reference = const std::string_view&;
+      using pointer = const std::string_view*;
+
+      iterator() noexcept = default;
+
+      iterator(const tokenizer* tokenizer_, std::string_view rest_) noexcept : _tokenizer(tokenizer_), _rest(rest_) {
+        advance();
+      }
+
+      reference operator*() const noexcept {
+        return _token;
+      }
+
+      pointer operator->() const noexcept {
+        return &_token;
+      }
+
+      iterator& operator++() noexcept {
+        advance();
+        return *this;
+      }
+
+      iterator operator++(int) noexcept {
+        auto copy = *this;
+        advance();
+        return copy;
+      }
+
+      bool operator==(const iterator& other_) const noexcept {
+        return _tokenizer == other_._tokenizer && _token.data() == other_._token.data();
+      }
+
+      bool operator!=(const iterator& other_) const noexcept {
+        return !(*this == other_);
+      }
+
+    private:
+      void advance() noexcept {
+        while (_tokenizer != nullptr) {
+          if (_rest.data() == nullptr) {
+            // nothing left after the last separator
+            *this = iterator{};
+            return;
+          }
+
+          const char* begin = _rest.data();
+          const char* end = begin + _rest.size();
+          const char* separator = _tokenizer->find_separator(begin, end);
+
+          _rest = (separator == end) ? std::string_view{} : std::string_view{separator + 1, static_cast<std::size_t>(end - separator - 1)};
+          _token = _tokenizer->trim(std::string_view{begin, static_cast<std::size_t>(separator - begin)});
+          if (!_token.empty()) {
+            return;
+          }
+        }
+      }
+
+      const tokenizer* _tokenizer{nullptr};
+      std::string_view _rest{};
+      std::string_view _token{};
+    };
+
+    explicit tokenizer(std::string_view source_, std::string_view separators_ = default_separators) :
+    _source(source_.data() == nullptr ? std::string_view{"", 0} : source_),
+    _separatorCount(separators_.size()) {
+      if (separators_.empty()) {
+        throw std::runtime_error{"At least one separator is needed"};
+      }
+
+      for (unsigned char c : separators_) {
+        _isSeparator[c] = true;
+      }
+      for (unsigned char c : std::string_view{" \t\n\v\f\r"}) {
+        _isWhitespace[c] = true;
+      }
+
+#if defined(__SSE2__)
+      for (std::size_t i = 0; i < separators_.size() && i < max_simd_separators; ++i) {
+        _simdSeparators[i] = _mm_set1_epi8(separators_[i]);
+      }
+#endif
+    }
+
+    iterator begin() const noexcept {
+      return iterator{this, _source};
+    }
+
+    iterator end() const noexcept {
+      return iterator{};
+    }
+
+    std::vector<std::string_view> to_vector() const {
+      return std::vector<std::string_view>(begin(), end());
+    }
+
+  private:
+
+    const char* find_separator(const char* begin_, const char* end_) const noexcept {
+#if defined(__SSE2__)
+      if (_separatorCount <= max_simd_separators) {
+        for (; end_ - begin_ >= 16; begin_ += 16) {
+          const auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(begin_));
+          auto matches = _mm_cmpeq_epi8(block, _simdSeparators[0]);
+          for (std::size_t i = 1; i < _separatorCount; ++i) {
+            matches = _mm_or_si128(matches, _mm_cmpeq_epi8(block, _simdSeparators[i]));
+          }
+          if (const auto mask = static_cast<unsigned>(_mm_movemask_epi8(matches)); mask != 0) {
+            return begin_ + __builtin_ctz(mask);
+          }
+        }
+      }
+#endif
+      while (begin_ != end_ && !_isSeparator[static_cast<unsigned char>(*begin_)]) {
+        ++begin_;
+      }
+      return begin_;
+    }
+
+    std::string_view trim(std::string_view token_) const noexcept {
+      while (!token_.empty() && _isWhitespace[static_cast<unsigned char>(token_.front())]) {
+        token_.remove_prefix(1);
+      }
+      while (!token_.empty() && _isWhitespace[static_cast<unsigned char>(token_.back())]) {
+        token_.remove_suffix(1);
+      }
+      return token_;
+    }
+
+    std::string_view _source;
+    std::size_t _separatorCount;
+    std::array<bool, 256> _isSeparator{};
+    std::array<bool, 256> _isWhitespace{};
+#if defined(__SSE2__)
+    __m128i _simdSeparators[max_simd_separators]{}; // std::array drops the alignment attributes of __m128i
+#endif
+  };
+}
@@ -1,26 +1,71 @@
 #pragma once
 
+#include <cstddef>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 
-template <typename Tuple, typename Functor, size_t Index = 0>
-auto tuple_for_each(const Tuple& tuple_, const Functor &functor_) -> void
-{
-  // purely for academic purpose: to verify that tuple is a reference to a const Tuple object
-  static_assert(!std::is_const_v<decltype(tuple_)>);
-  static_assert(std::is_const_v<std::remove_reference_t<decltype(tuple_)>>);
+/**
+ * Algorithms over the elements of a tuple, all of them are single fold expressions
+ * instead of one template instantiation per element, which keeps the instantiation depth constant
+ * and the compile time low for wide tuples (e.g. reflect() of a struct with 100 members)
+ *
+ * All of them take the tuple by forwarding reference:
+ *  => a tuple of lvalue references (what std::tie returns) gives mutable access to the referenced
+ *     variables even when the tuple itself is const, as the const-ness of the tuple doesn't propagate
+ *     to its referenced variables (references are inherently constant)
+ *  => a non-const tuple of values gives mutable access to its own elements
+ */
+
+namespace tuple_detail {
+  template <typename Tuple>
+  using tuple_indices = std::make_index_sequence<std::tuple_size_v<std::remove_reference_t<Tuple>>>;
 
-  constexpr auto tupleSize = std::tuple_size_v<Tuple>;
-  if constexpr (Index < tupleSize)
+  template <typename Tuple, typename Functor, std::size_t... Indices>
+  void tuple_for_each_indexed(Tuple&& tuple_, Functor& functor_, std::index_sequence<Indices...>)
   {
-    // purely for academic purpose: to verify that each member is indeed an lvalue reference
-    static_assert(std::is_lvalue_reference_v<decltype(std::get<Index>(tuple_))>);
+    (functor_(std::integral_constant<std::size_t, Indices>{}, std::get<Indices>(tuple_)), ...);
+  }
 
-    // constant tuple doesn't stop its members from getting modified
-    // as their members are all lvalue references (references are inherently constant)
-    // and the const-ness of tuple doesn't propagate to its referenced variables
-    auto& value = std::get<Index>(tuple_);
-    functor_(value);
+  template <typename Tuple, typename Predicate, std::size_t... Indices>
+  bool tuple_any_of(Tuple&& tuple_, Predicate& predicate_, std::index_sequence<Indices...>)
+  {
+    return (static_cast<bool>(predicate_(std::get<Indices>(tuple_))) || ...);
+  }
 
-    tuple_for_each<Tuple, Functor, Index + 1>(tuple_, functor_);
+  template <typename Tuple, typename Predicate, std::size_t... Indices>
+  bool tuple_all_of(Tuple&& tuple_, Predicate& predicate_, std::index_sequence<Indices...>)
+  {
+    return (static_cast<bool>(predicate_(std::get<Indices>(tuple_))) && ...);
   }
-}
\ No newline at end of file
+}
+
+// calls @functor_ with every element, in order
+template <typename Tuple, typename Functor>
+auto tuple_for_each(Tuple&& tuple_, Functor&& functor_) -> void
+{
+  std::apply([&functor_](auto&&... elems_) { (functor_(std::forward<decltype(elems_)>(elems_)), ...); },
+             std::forward<Tuple>(tuple_));
+}
+
+// calls @functor_ with (std::integral_constant<std::size_t, Index>, element), in order
+// as index is a compile time constant, it can be used with std::get, std::tuple_element_t, etc.
+template <typename Tuple, typename Functor>
+auto tuple_for_each_indexed(Tuple&& tuple_, Functor&& functor_) -> void
+{
+  tuple_detail::tuple_for_each_indexed(std::forward<Tuple>(tuple_), functor_, tuple_detail::tuple_indices<Tuple>{});
+}
+
+// stops at the first element for which @predicate_ returns true
+template <typename Tuple, typename Predicate>
+auto tuple_any_of(Tuple&& tuple_, Predicate&& predicate_) -> bool
+{
+  return tuple_detail::tuple_any_of(std::forward<Tuple>(tuple_), predicate_, tuple_detail::tuple_indices<Tuple>{});
+}
+
+// stops at the first element for which @predicate_ returns false
+template <typename Tuple, typename Predicate>
+auto tuple_all_of(Tuple&& tuple_, Predicate&& predicate_) -> bool
+{
+  return tuple_detail::tuple_all_of(std::forward<Tuple>(tuple_), predicate_, tuple_detail::tuple_indices<Tuple>{});
+}
@@ -1,11 +1,46 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
-#include <exception>
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
 
 namespace my {
 
-  template<typename T, std::size_t MaxSize = 10>
+  /**
+   * How vectors validate their accesses:
+   *  => checked: throws std::runtime_error on invalid access (default)
+   *  => debug_checked: asserts, hence the check disappears with NDEBUG
+   *  => unchecked: no check at all, element access is as cheap as that of a raw array
+   */
+  enum class access_policy {
+    checked,
+    debug_checked,
+    unchecked
+  };
+
+  namespace detail {
+    template <access_policy Policy>
+    constexpr void check_access(bool valid, const char* message) {
+      if constexpr (Policy == access_policy::checked) {
+        if (!valid) {
+          throw std::runtime_error{message};
+        }
+      }
+      else if constexpr (Policy == access_policy::debug_checked) {
+        assert(valid && message);
+      }
+    }
+  }
+
+  template<typename T, std::size_t MaxSize = 10, access_policy Policy = access_policy::checked>
   class static_vector {
 
   public:
@@ -19,12 +54,17 @@ namespace my {
 
     constexpr const T& back() const {
       must_not_be_empty();
-      return _values.at(_index-1);
+      return _values[_index-1];
     }
 
     constexpr const T& front() const {
       must_not_be_empty();
-      return _values.at(_index-1);
+      return _values[0];
+    }
+
+    constexpr T& operator[](std::size_t index) {
+      must_be_valid_access(index);
+      return _values[index];
     }
 
     constexpr const T& operator[](std::size_t index) const {
@@ -58,24 +98,318 @@ namespace my {
 
   private:
     constexpr void must_not_be_empty() const {
-      if (_index == 0) {
-        throw std::runtime_error{"Empty array"};
-      }
+      detail::check_access<Policy>(_index != 0, "Empty array");
     }
 
     constexpr void must_not_be_full() const {
-      if (_index == _values.size()) {
-        throw std::runtime_error{"Array is full"};
-      }
+      detail::check_access<Policy>(_index != _values.size(), "Array is full");
     }
 
     constexpr void must_be_valid_access(std::size_t index) const {
-      if (index >= this->size()) {
-        throw std::runtime_error{"Invalid access"};
-      }
+      detail::check_access<Policy>(index < this->size(), "Invalid access");
     }
 
     std::size_t _index{0}; // index where next element will be placed
     std::array<T, MaxSize> _values{};
   };
+
+  /**
+   * A vector which keeps up to InlineSize elements in an inline buffer
+   * and transparently spills over to heap beyond that.
+   * Unlike static_vector, inline buffer is uninitialized: an element is constructed
+   * only when it is pushed, hence this can't be used in constexpr context
+   */
+  template<typename T, std::size_t InlineSize = 10, access_policy Policy = access_policy::checked>
+  class small_vector {
+    static_assert(InlineSize > 0, "small_vector needs room for at least one inline element");
+
+  public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = T&;
+    using const_reference = const T&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    small_vector() noexcept = default;
+
+    // delegating to default constructor so that destructor cleans up if an element throws
+    small_vector(std::initializer_list<T> values) : small_vector() {
+      reserve(values.size());
+      for (const auto& value : values) {
+        emplace_back(value);
+      }
+    }
+
+    small_vector(const small_vector& other) : small_vector() {
+      reserve(other.size());
+      for (const auto& value : other) {
+        emplace_back(value);
+      }
+    }
+
+    // heap buffer is stolen, inline elements are moved one by one
+    small_vector(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+      steal(std::move(other));
+    }
+
+    small_vector& operator=(const small_vector& other) {
+      if (this != &other) {
+        small_vector copy{other};
+        clear();
+        release();
+        steal(std::move(copy));
+      }
+      return *this;
+    }
+
+    small_vector& operator=(small_vector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+      if (this != &other) {
+        clear();
+        release();
+        steal(std::move(other));
+      }
+      return *this;
+    }
+
+    ~small_vector() {
+      clear();
+      release();
+    }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+      if (_size == _capacity) {
+        // new element is constructed before the old ones are moved
+        // as args might be referring to one of the existing elements
+        const auto new_capacity = _capacity * 2;
+        T* new_data = allocate(new_capacity);
+        try {
+          ::new (static_cast<void*>(new_data + _size)) T(std::forward<Args>(args)...);
+        }
+        catch (...) {
+          deallocate(new_data, new_capacity);
+          throw;
+        }
+
+        try {
+          relocate(new_data, new_capacity);
+        }
+        catch (...) {
+          new_data[_size].~T();
+          deallocate(new_data, new_capacity);
+          throw;
+        }
+      }
+      else {
+        ::new (static_cast<void*>(_data + _size)) T(std::forward<Args>(args)...);
+      }
+      return _data[_size++];
+    }
+
+    void push_back(const T& value) {
+      emplace_back(value);
+    }
+
+    void push_back(T&& value) {
+      emplace_back(std::move(value));
+    }
+
+    void pop_back() {
+      must_not_be_empty();
+      _data[--_size].~T();
+    }
+
+    iterator insert(const_iterator pos, T value) {
+      const auto index = pos - begin();
+      must_be_valid_position(index);
+      emplace_back(std::move(value));
+      std::rotate(begin() + index, end() - 1, end());
+      return begin() + index;
+    }
+
+    iterator erase(const_iterator pos) {
+      return erase(pos, pos + 1);
+    }
+
+    iterator erase(const_iterator first, const_iterator last) {
+      const auto index = first - begin();
+      const auto count = last - first;
+      must_be_valid_position(index);
+      must_be_valid_position(index + count);
+
+      std::move(begin() + index + count, end(), begin() + index);
+      std::destroy(end() - count, end());
+      _size -= count;
+      return begin() + index;
+    }
+
+    void reserve(std::size_t new_capacity) {
+      if (new_capacity > _capacity) {
+        T* new_data = allocate(new_capacity);
+        try {
+          relocate(new_data, new_capacity);
+        }
+        catch (...) {
+          deallocate(new_data, new_capacity);
+          throw;
+        }
+      }
+    }
+
+    void clear() noexcept {
+      std::destroy(begin(), end());
+      _size = 0;
+    }
+
+    T& operator[](std::size_t index) {
+      must_be_valid_access(index);
+      return _data[index];
+    }
+
+    const T& operator[](std::size_t index) const {
+      must_be_valid_access(index);
+      return _data[index];
+    }
+
+    T& back() {
+      must_not_be_empty();
+      return _data[_size-1];
+    }
+
+    const T& back() const {
+      must_not_be_empty();
+      return _data[_size-1];
+    }
+
+    T& front() {
+      must_not_be_empty();
+      return _data[0];
+    }
+
+    const T& front() const {
+      must_not_be_empty();
+      return _data[0];
+    }
+
+    std::size_t size() const noexcept {
+      return _size;
+    }
+
+    bool empty() const noexcept {
+      return _size == 0;
+    }
+
+    std::size_t capacity() const noexcept {
+      return _capacity;
+    }
+
+    static constexpr std::size_t inline_size() noexcept {
+      return InlineSize;
+    }
+
+    // true as long as elements haven't spilled over to heap
+    bool is_inline() const noexcept {
+      return _data == inline_data();
+    }
+
+    T* data() noexcept {
+      return _data;
+    }
+
+    const T* data() const noexcept {
+      return _data;
+    }
+
+    iterator begin() noexcept {
+      return _data;
+    }
+
+    const_iterator begin() const noexcept {
+      return _data;
+    }
+
+    iterator end() noexcept {
+      return _data + _size;
+    }
+
+    const_iterator end() const noexcept {
+      return _data + _size;
+    }
+
+  private:
+    T* inline_data() noexcept {
+      return std::launder(reinterpret_cast<T*>(_inline));
+    }
+
+    const T* inline_data() const noexcept {
+      return std::launder(reinterpret_cast<const T*>(_inline));
+    }
+
+    static T* allocate(std::size_t capacity) {
+      return std::allocator<T>{}.allocate(capacity);
+    }
+
+    static void deallocate(T* data, std::size_t capacity) noexcept {
+      std::allocator<T>{}.deallocate(data, capacity);
+    }
+
+    // frees the heap buffer (if any), elements must already be destroyed
+    void release() noexcept {
+      if (!is_inline()) {
+        deallocate(_data, _capacity);
+      }
+      _data = inline_data();
+      _capacity = InlineSize;
+    }
+
+    // moves all elements to @new_data, which then becomes the only buffer
+    // if moving/copying throws, *this is left untouched and caller still owns @new_data
+    void relocate(T* new_data, std::size_t new_capacity) {
+      if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+        std::uninitialized_move(begin(), end(), new_data);
+      }
+      else {
+        std::uninitialized_copy(begin(), end(), new_data);
+      }
+
+      const auto size = _size;
+      clear();
+      release();
+      _data = new_data;
+      _size = size;
+      _capacity = new_capacity;
+    }
+
+    // *this must be empty and inline
+    void steal(small_vector&& other) {
+      if (other.is_inline()) {
+        std::uninitialized_move(other.begin(), other.end(), _data);
+        _size = other._size;
+        other.clear();
+      }
+      else {
+        _data = std::exchange(other._data, other.inline_data());
+        _size = std::exchange(other._size, 0);
+        _capacity = std::exchange(other._capacity, InlineSize);
+      }
+    }
+
+    void must_not_be_empty() const {
+      detail::check_access<Policy>(_size != 0, "Empty array");
+    }
+
+    void must_be_valid_access(std::size_t index) const {
+      detail::check_access<Policy>(index < _size, "Invalid access");
+    }
+
+    void must_be_valid_position(std::ptrdiff_t index) const {
+      detail::check_access<Policy>(index >= 0 && static_cast<std::size_t>(index) <= _size, "Invalid position");
+    }
+
+    alignas(T) unsigned char _inline[sizeof(T) * InlineSize];
+    T* _data{inline_data()};
+    std::size_t _size{0};
+    std::size_t _capacity{InlineSize};
+  };
 }
\ No newline at end of file
@@ -1,15 +1,34 @@
 #pragma once
 
+#include "BloomFilter.h"
 #include "CharPrimeMap.h"
+#include "LRUCache.h"
+#include "ThreadPool.h"
+#include "Vector.h"
 
+#include <algorithm>
+#include <array>
+#include <memory_resource>
+#include <optional>
+#include <stdexcept>
 #include <unordered_map>
 #include <string>
+#include <string_view>
 #include <vector>
 
 class WordContainer {
 public:
   using key_t = uint64_t;
-  using storage_t = std::unordered_map<key_t, std::string>;
+  // words never exceed the small string buffer, hence only the nodes (and buckets) of the map allocate
+  using storage_t = std::pmr::unordered_map<key_t, std::string>;
+
+  WordContainer() = default;
+
+  /**
+   * Nodes of the map allocate from @resource, which must outlive the container
+   * e.g. a std::pmr::monotonic_buffer_resource for a container that's built once and only queried after
+   */
+  explicit WordContainer(std::pmr::memory_resource* resource);
 
   /**
    * Adds to the existing collection, doesn't handle anagrams yet
@@ -18,10 +37,57 @@ public:
    */
   void add(std::string str);
 
+  /**
+   * Query path doesn't allocate: all the scratch space lives in fixed size static_vectors
+   * (unless result cache is enabled, where a miss allocates the cached result list)
+   * Only first max_key_width chars of @str are considered
+   */
+  template <typename OutItr>
+  void get(std::string_view str, OutItr outItr);
+
+  static constexpr std::size_t default_split_letters{3};
+
+  /**
+   * Same words, in the same order, as get(), but the subsets of @str are split into 2^splitLetters
+   * independent ranges by fixing the inclusion of its last @splitLetters chars, and the ranges are
+   * evaluated in parallel on @pool. Every range collects its words into a buffer of its own, and the buffers
+   * are appended to @outItr in range order once all of them are done, hence no locking
+   * Allocates the per-range buffers, and bypasses the result cache
+   */
   template <typename OutItr>
-  void get(const std::string &str, OutItr outItr);
+  void get(std::string_view str, OutItr outItr, my::thread_pool& pool, std::size_t splitLetters = default_split_letters);
+
+  /**
+   * Results of up to @maxEntries most recently used queries are cached, so a repeated query
+   * doesn't enumerate and look up all the subsets again. As the key of a query is the product of
+   * the primes of its chars, anagrams (e.g. "abc" and "cab") share their entry: they get the same words,
+   * but in the order of the query that filled the entry, which isn't necessarily their own uncached order
+   * The cache is cleared whenever add() adds a new word
+   */
+  void enableResultCache(std::size_t maxEntries);
+
+  void disableResultCache();
+
+  bool contains(std::string_view str);
+
+  /**
+   * Keeps an index of the deletion neighbourhood of every word (its key divided by the prime of each of
+   * its distinct chars, so one key per one-char-removed word), which getSimilar() needs
+   * Index is built from the existing words, and add() keeps it up to date while enabled
+   */
+  void enableSimilarIndex();
+
+  void disableSimilarIndex();
 
-  bool contains(const std::string& str);
+  /**
+   * Words within a single edit of @str: with one char of @str deleted, one char inserted, or one char
+   * substituted (all letter multisets, as for get()), the exact match (if any) included and first
+   * Takes at most 2 + 2 * (number of distinct chars of @str) probes, instead of trying every edit
+   * @str is up to max_key_width + 1 chars long (longer ones can't be an edit away from any word)
+   * Throws std::runtime_error if the similar index isn't enabled
+   */
+  template <typename OutItr>
+  void getSimilar(std::string_view str, OutItr outItr);
 
 private:
 
@@ -32,31 +98,205 @@ private:
   // std::numeric_limits<uint64_t>::max();
   static constexpr key_t max_key_width{8};
 
+  // per-query scratch, sized for the widest supported query, hence no heap allocation
+  // small_vector leaves its inline buffer uninitialized, so ~2KB of permutations aren't zeroed per query
+  // queries are truncated to max_key_width, so these can never overflow: assert only in debug builds
+  using keys_t = my::static_vector<key_t, max_key_width, my::access_policy::debug_checked>;
+  using permutations_t = my::small_vector<key_t, (1ull << max_key_width) - 1, my::access_policy::debug_checked>;
+
   /**
-   * @permutations must already be big enough to store all permutations of keys
+   * @permutations must be empty, all 2^n-1 permutations of keys are appended to it
    */
-  static void getAllKeyPermutations(const std::vector<key_t> &keys, std::size_t index, std::vector<key_t>& permutations);
+  static void getAllKeyPermutations(const keys_t &keys, std::size_t index, permutations_t& permutations);
+
+  key_t getKey(std::string_view key);
+
+  keys_t getKeys(std::string_view str);
+
+  // index of the lowest set bit of @i, which mustn't be 0
+  static std::size_t lowestBit(std::size_t i) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::size_t>(__builtin_ctzll(i));
+#else
+    std::size_t bit{0};
+    while ((i & 1) == 0) {
+      i >>= 1;
+      ++bit;
+    }
+    return bit;
+#endif
+  }
+
+  // calls @func with the key and the word of every word made of a subset of chars of @str
+  template <typename Func>
+  void forEachWord(std::string_view str, Func&& func);
+
+  // pointers to the words in _map, which stay valid as nodes of unordered_map don't move
+  using results_t = std::vector<const std::string*>;
+
+  // keys rather than pointers, as the nodes of _map do move when a container is copied, or is moved
+  // to one of another memory resource; words are looked up again on a hit, which is still a single probe per word
+  using cached_results_t = std::vector<key_t>;
 
-  key_t getKey(const std::string& key);
+  // grows the filter (doubling its capacity) by rebuilding it from the keys in _map
+  void growFilter();
 
-  std::vector<key_t> getKeys(const std::string &str);
+  void addDeletions(key_t key, std::string_view word);
 
   storage_t _map;
   my::alphabet_char_prime_map _charMap{};
+
+  // most of the keys of a query are misses, the filter rules them out without probing _map
+  my::blocked_bloom_filter _filter{};
+  std::optional<LRUCache<key_t, cached_results_t>> _resultCache{};
+
+  // deletion neighbourhood key -> key of the word it's a deletion of
+  using deletions_t = std::pmr::unordered_multimap<key_t, key_t>;
+  std::optional<deletions_t> _deletions{};
 };
 
 template<typename OutItr>
-void WordContainer::get(const std::string &str, OutItr outItr) {
-  const auto& queryStr = (str.size() > max_key_width) ? str.substr(0, max_key_width) : str;
-  auto keys = getKeys(queryStr);
-  auto all_permutation_size = (1ull << queryStr.size()) - 1;
-  std::vector<key_t> all_permutation(all_permutation_size);
-  getAllKeyPermutations(getKeys(queryStr), 0, all_permutation);
+void WordContainer::get(std::string_view str, OutItr outItr) {
+  const auto queryStr = str.substr(0, max_key_width);
+  if (!_resultCache) {
+    forEachWord(queryStr, [&outItr](key_t, const std::string& word) { outItr = word; });
+    return;
+  }
+
+  const auto key = getKey(queryStr);
+  auto cacheItr = _resultCache->get(key);
+  if (cacheItr == _resultCache->end()) {
+    cached_results_t results{};
+    forEachWord(queryStr, [&results](key_t wordKey, const std::string&) { results.push_back(wordKey); });
+    results.shrink_to_fit();
+    cacheItr = _resultCache->insert(key, std::move(results));
+  }
+
+  for (auto wordKey : cacheItr->second) {
+    outItr = _map.find(wordKey)->second; // the cache is cleared whenever a word is added, and none are removed
+  }
+}
+
+template<typename OutItr>
+void WordContainer::get(std::string_view str, OutItr outItr, my::thread_pool& pool, std::size_t splitLetters) {
+  const auto keys = getKeys(str.substr(0, max_key_width));
+  const auto split = std::min<std::size_t>(splitLetters, keys.size());
+  const auto rest = keys.size() - split;
+
+  // products of every subset of the first @rest keys (bit i of the index for keys[i]), shared by all the ranges
+  std::array<key_t, 1ull << max_key_width> products{};
+  products[0] = 1;
+  for (std::size_t i = 1; i < (1ull << rest); ++i) {
+    products[i] = products[i & (i - 1)] * keys[lowestBit(i)];
+  }
+
+  // subset of range r and index i is (r << rest) | i, hence ranges in order enumerate the subsets
+  // in the same order as getAllKeyPermutations (range 0 skips the empty subset)
+  std::vector<results_t> ranges(1ull << split);
+  pool.parallel_for(ranges.size(), [&](std::size_t range) {
+    key_t fixed{1};
+    for (std::size_t i = 0; i < split; ++i) {
+      if (range & (1ull << i)) {
+        fixed *= keys[rest + i];
+      }
+    }
+
+    auto& results = ranges[range];
+    for (std::size_t i = (range == 0) ? 1 : 0; i < (1ull << rest); ++i) {
+      const auto key = fixed * products[i];
+      if (!_filter.may_contain(key)) {
+        continue;
+      }
+      auto itr = _map.find(key);
+      if (itr != _map.end()) {
+        results.push_back(&itr->second);
+      }
+    }
+  });
+
+  for (const auto& results : ranges) {
+    for (const auto* word : results) {
+      outItr = *word;
+    }
+  }
+}
+
+template<typename OutItr>
+void WordContainer::getSimilar(std::string_view str, OutItr outItr) {
+  if (!_deletions) {
+    throw std::runtime_error{"Similar index is not enabled"};
+  }
+  if (str.size() > max_key_width + 1) {
+    return;
+  }
+
+  my::static_vector<key_t, max_key_width + 1, my::access_policy::debug_checked> primes{};
+  for (auto c : str) {
+    primes.push_back(_charMap.prime(c));
+  }
+
+  auto probeWords = [this, &outItr](key_t key) {
+    if (_filter.may_contain(key)) {
+      if (auto itr = _map.find(key); itr != _map.end()) {
+        outItr = itr->second;
+      }
+    }
+  };
+  // primes are unique factors, hence a word is reached by a single probe (and a single entry of it),
+  // except for the exact match, which substituting a char with itself reaches as well: @skip_ filters it out
+  auto probeDeletions = [this, &outItr](key_t key, key_t skip_) {
+    for (auto [itr, last] = _deletions->equal_range(key); itr != last; ++itr) {
+      if (itr->second != skip_) {
+        outItr = _map.find(itr->second)->second;
+      }
+    }
+  };
+
+  // product of all max_key_width + 1 chars might overflow, but then neither str nor str plus a char is a word
+  const bool fits = primes.size() <= max_key_width;
+  key_t key{1};
+  if (fits) {
+    for (auto prime : primes) {
+      key *= prime;
+    }
+    probeWords(key); // exact
+    probeDeletions(key, 0); // word is str with a char inserted
+  }
+
+  for (std::size_t i = 0; i < primes.size(); ++i) {
+    if (std::find(primes.begin(), primes.begin() + i, primes[i]) != primes.begin() + i) {
+      continue; // same deletion as an earlier char
+    }
+
+    key_t deleted{1};
+    if (fits) {
+      deleted = key / primes[i];
+    }
+    else {
+      for (std::size_t j = 0; j < primes.size(); ++j) {
+        deleted *= (j == i) ? 1 : primes[j];
+      }
+    }
+
+    probeWords(deleted); // word is str with a char deleted
+    if (fits) {
+      probeDeletions(deleted, key); // word is str with a char substituted
+    }
+  }
+}
+
+template<typename Func>
+void WordContainer::forEachWord(std::string_view str, Func&& func) {
+  permutations_t all_permutation{};
+  getAllKeyPermutations(getKeys(str), 0, all_permutation);
 
   for (auto key : all_permutation) {
+    if (!_filter.may_contain(key)) {
+      continue;
+    }
     auto itr = _map.find(key);
     if (itr != _map.end()) {
-      outItr = itr->second;
+      func(itr->first, itr->second);
     }
   }
 }
\ No newline at end of file
@@ -1,9 +1,179 @@
 #pragma once
 
-/** This contains constexpr version of some algorithms from algorithm header */
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if !defined(MY_ALGORITHM_NO_PARALLEL) && __has_include(<execution>)
+#include <execution>
+#if defined(__cpp_lib_execution)
+#define MY_ALGORITHM_PARALLEL
+#endif
+#endif
+
+/**
+ * This contains constexpr version of some algorithms from algorithm header
+ *
+ * All of them are usable in constant expressions (e.g. to build compile time tables),
+ * but when evaluated at runtime, these dispatch to faster implementations:
+ *  => unrolled kernels (with independent accumulators, so that compiler can vectorize them)
+ *     for contiguous ranges of arithmetic types
+ *  => std::execution::par_unseq for ranges of at least detail::parallel_threshold elements on multi core machines
+ *     (unless MY_ALGORITHM_NO_PARALLEL is defined or standard library doesn't have <execution>)
+ *
+ * Like the parallel algorithms of standard library, functors must not have side effects
+ * as they might be invoked concurrently and in any order
+ */
 
 namespace my {
 
+  namespace detail {
+
+    // std::is_constant_evaluated is C++20, but the builtin is available in C++17 mode as well
+    // if there is no way to tell, always take the constexpr path
+    constexpr bool is_constant_evaluated() noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+      return __builtin_is_constant_evaluated();
+#else
+      return true;
+#endif
+    }
+
+    // below this, cost of spawning tasks exceeds the gain
+    constexpr std::ptrdiff_t parallel_threshold{1 << 16};
+
+    template <typename Itr>
+    constexpr bool is_random_access_v =
+      std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<Itr>::iterator_category>;
+
+    template <typename T>
+    constexpr bool is_char_v = std::is_same_v<T, char> || std::is_same_v<T, wchar_t> ||
+      std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t>;
+
+    // basic_string is only specified for character types, hence it's only instantiated for those
+    template <typename Itr, typename T, bool = is_char_v<T>>
+    constexpr bool is_string_iterator_v = false;
+
+    template <typename Itr, typename T>
+    constexpr bool is_string_iterator_v<Itr, T, true> =
+      std::is_same_v<Itr, typename std::basic_string<T>::iterator> ||
+      std::is_same_v<Itr, typename std::basic_string<T>::const_iterator>;
+
+    // C++17 has no way to tell a contiguous iterator, hence pointers and iterators of known contiguous containers
+    // (but vector<bool>, whose bits are behind a proxy iterator)
+    template <typename Itr, typename T = typename std::iterator_traits<Itr>::value_type>
+    constexpr bool is_contiguous_v =
+      std::is_pointer_v<Itr> ||
+      (!std::is_same_v<T, bool> && std::is_same_v<Itr, typename std::vector<T>::iterator>) ||
+      (!std::is_same_v<T, bool> && std::is_same_v<Itr, typename std::vector<T>::const_iterator>) ||
+      is_string_iterator_v<Itr, T>;
+
+    template <typename Itr>
+    constexpr bool is_contiguous_arithmetic_v =
+      is_contiguous_v<Itr> && std::is_arithmetic_v<typename std::iterator_traits<Itr>::value_type>;
+
+    // on a single core, parallel execution is pure overhead
+    inline bool has_multiple_cores() {
+      static const bool multiple_cores{std::thread::hardware_concurrency() > 1};
+      return multiple_cores;
+    }
+
+    template <typename Itr>
+    bool use_parallel(Itr begin, Itr end) {
+      if constexpr (is_random_access_v<Itr>) {
+        return std::distance(begin, end) >= parallel_threshold && has_multiple_cores();
+      }
+      return false;
+    }
+
+    template <typename Itr>
+    auto to_pointer(Itr itr) {
+      return std::addressof(*itr);
+    }
+
+    template <typename T>
+    constexpr void swap(T& left, T& right) {
+      T tmp = std::move(left);
+      left = std::move(right);
+      right = std::move(tmp);
+    }
+
+    template <typename T, typename Func>
+    std::ptrdiff_t count_if_kernel(const T* begin, const T* end, const Func& func) {
+      std::ptrdiff_t counts[4]{};
+      for (; end - begin >= 4; begin += 4) {
+        counts[0] += static_cast<bool>(func(begin[0]));
+        counts[1] += static_cast<bool>(func(begin[1]));
+        counts[2] += static_cast<bool>(func(begin[2]));
+        counts[3] += static_cast<bool>(func(begin[3]));
+      }
+      for (; begin != end; ++begin) {
+        counts[0] += static_cast<bool>(func(*begin));
+      }
+      return counts[0] + counts[1] + counts[2] + counts[3];
+    }
+
+    template <typename T, typename Value>
+    Value accumulate_kernel(const T* begin, const T* end, Value init) {
+      Value sums[4]{init, Value{}, Value{}, Value{}};
+      for (; end - begin >= 4; begin += 4) {
+        sums[0] += begin[0];
+        sums[1] += begin[1];
+        sums[2] += begin[2];
+        sums[3] += begin[3];
+      }
+      for (; begin != end; ++begin) {
+        sums[0] += *begin;
+      }
+      return (sums[0] + sums[1]) + (sums[2] + sums[3]);
+    }
+
+    // branch free, hence no misprediction per step, as only the loop count depends on the data size
+    template <typename T, typename Value>
+    const T* lower_bound_kernel(const T* begin, std::size_t length, const Value& value) {
+      while (length > 1) {
+        const auto half = length / 2;
+        begin = (begin[half] < value) ? begin + half : begin;
+        length -= half;
+      }
+      return begin + (*begin < value);
+    }
+
+    template <typename Itr, typename Compare>
+    constexpr void sift_down(Itr begin, std::ptrdiff_t root, std::ptrdiff_t length, const Compare& comp) {
+      for (auto child = 2 * root + 1; child < length; child = 2 * root + 1) {
+        if (child + 1 < length && comp(begin[child], begin[child + 1])) {
+          ++child;
+        }
+        if (!comp(begin[root], begin[child])) {
+          return;
+        }
+        detail::swap(begin[root], begin[child]);
+        root = child;
+      }
+    }
+
+    // heap sort: O(n log n) even in the worst case and no recursion, which suits constant evaluation
+    template <typename Itr, typename Compare>
+    constexpr void heap_sort(Itr begin, Itr end, const Compare& comp) {
+      const auto length = end - begin;
+      for (auto root = length / 2 - 1; root >= 0; --root) {
+        sift_down(begin, root, length, comp);
+      }
+      for (auto last = length - 1; last > 0; --last) {
+        detail::swap(begin[0], begin[last]);
+        sift_down(begin, 0, last, comp);
+      }
+    }
+  }
+
   template <typename Itr, typename Value>
   constexpr inline void iota(Itr begin, Itr end, Value initial_value) {
     while (begin != end) {
@@ -16,6 +186,16 @@ namespace my {
   //  as std::find is not constexpr
   template <typename Itr, typename Func>
   constexpr inline Itr find_if(Itr begin, Itr end, const Func& func) {
+    if (!detail::is_constant_evaluated()) {
+#if defined(MY_ALGORITHM_PARALLEL)
+      if (detail::use_parallel(begin, end)) {
+        return std::find_if(std::execution::par_unseq, begin, end, func);
+      }
+#endif
+      // already unrolled for random access iterators
+      return std::find_if(begin, end, func);
+    }
+
     while (begin != end) {
       if (func(*begin)) {
         return begin;
@@ -25,4 +205,154 @@ namespace my {
 
     return end;
   }
-}
\ No newline at end of file
+
+  template <typename Itr, typename Func>
+  constexpr inline auto count_if(Itr begin, Itr end, const Func& func) {
+    using difference_type = typename std::iterator_traits<Itr>::difference_type;
+
+    if (!detail::is_constant_evaluated()) {
+#if defined(MY_ALGORITHM_PARALLEL)
+      if (detail::use_parallel(begin, end)) {
+        return std::count_if(std::execution::par_unseq, begin, end, func);
+      }
+#endif
+      if constexpr (detail::is_contiguous_arithmetic_v<Itr>) {
+        if (begin != end) {
+          const auto* first = detail::to_pointer(begin);
+          return static_cast<difference_type>(detail::count_if_kernel(first, first + (end - begin), func));
+        }
+        return difference_type{0};
+      }
+    }
+
+    difference_type count{0};
+    while (begin != end) {
+      if (func(*begin)) {
+        count++;
+      }
+      begin++;
+    }
+
+    return count;
+  }
+
+  template <typename InItr, typename OutItr, typename Func>
+  constexpr inline OutItr transform(InItr begin, InItr end, OutItr out, const Func& func) {
+    if (!detail::is_constant_evaluated()) {
+#if defined(MY_ALGORITHM_PARALLEL)
+      if constexpr (detail::is_random_access_v<OutItr>) {
+        if (detail::use_parallel(begin, end)) {
+          return std::transform(std::execution::par_unseq, begin, end, out, func);
+        }
+      }
+#endif
+      return std::transform(begin, end, out, func);
+    }
+
+    while (begin != end) {
+      *out = func(*begin);
+      out++;
+      begin++;
+    }
+
+    return out;
+  }
+
+  /**
+   * Fast paths are only taken for integral values, as reordering the additions of floating point values
+   * would give a (slightly) different result than a sequential sum
+   */
+  template <typename Itr, typename Value>
+  constexpr inline Value accumulate(Itr begin, Itr end, Value init) {
+    using value_type = typename std::iterator_traits<Itr>::value_type;
+
+    if (!detail::is_constant_evaluated()) {
+      if constexpr (std::is_integral_v<value_type> && std::is_integral_v<Value>) {
+#if defined(MY_ALGORITHM_PARALLEL)
+        if (detail::use_parallel(begin, end)) {
+          return std::reduce(std::execution::par_unseq, begin, end, init);
+        }
+#endif
+        if constexpr (detail::is_contiguous_v<Itr>) {
+          if (begin != end) {
+            const auto* first = detail::to_pointer(begin);
+            return detail::accumulate_kernel(first, first + (end - begin), init);
+          }
+          return init;
+        }
+      }
+    }
+
+    while (begin != end) {
+      init = std::move(init) + *begin;
+      begin++;
+    }
+
+    return init;
+  }
+
+  // an arbitrary @func is not known to be associative, hence this one is always sequential
+  template <typename Itr, typename Value, typename Func>
+  constexpr inline Value accumulate(Itr begin, Itr end, Value init, const Func& func) {
+    while (begin != end) {
+      init = func(std::move(init), *begin);
+      begin++;
+    }
+
+    return init;
+  }
+
+  template <typename Itr, typename Compare>
+  constexpr inline void sort(Itr begin, Itr end, const Compare& comp) {
+    if (!detail::is_constant_evaluated()) {
+#if defined(MY_ALGORITHM_PARALLEL)
+      if (detail::use_parallel(begin, end)) {
+        std::sort(std::execution::par_unseq, begin, end, comp);
+        return;
+      }
+#endif
+      std::sort(begin, end, comp);
+      return;
+    }
+
+    detail::heap_sort(begin, end, comp);
+  }
+
+  template <typename Itr>
+  constexpr inline void sort(Itr begin, Itr end) {
+    my::sort(begin, end, std::less<>{});
+  }
+
+  template <typename Itr, typename Value, typename Compare>
+  constexpr inline Itr lower_bound(Itr begin, Itr end, const Value& value, const Compare& comp) {
+    auto length = std::distance(begin, end);
+    while (length > 0) {
+      const auto half = length / 2;
+      auto middle = std::next(begin, half);
+      if (comp(*middle, value)) {
+        begin = std::next(middle);
+        length -= half + 1;
+      }
+      else {
+        length = half;
+      }
+    }
+
+    return begin;
+  }
+
+  template <typename Itr, typename Value>
+  constexpr inline Itr lower_bound(Itr begin, Itr end, const Value& value) {
+    if (!detail::is_constant_evaluated()) {
+      if constexpr (detail::is_contiguous_arithmetic_v<Itr> && std::is_arithmetic_v<Value>) {
+        if (begin != end) {
+          const auto* first = detail::to_pointer(begin);
+          return std::next(begin, detail::lower_bound_kernel(first, end - begin, value) - first);
+        }
+        return end;
+      }
+    }
+
+    return my::lower_bound(begin, end, value, std::less<>{});
+  }
+}
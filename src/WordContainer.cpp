@@ -3,22 +3,76 @@
 #include <algorithm>
 #include <numeric>
 #include <initializer_list>
-#include <exception>
+#include <stdexcept>
+
+WordContainer::WordContainer(std::pmr::memory_resource* resource) : _map(resource) {}
 
 void WordContainer::add(std::string str) {
   if (str.size() > max_key_width) {
     throw std::runtime_error{"Length of {" + str + "} exceeds maximum supported length (8 chars)"};
   }
   auto key = getKey(str);
-  _map.emplace(key, std::move(str));
+  auto [itr, added] = _map.emplace(key, std::move(str));
+  if (!added) {
+    return;
+  }
+  if (_deletions) {
+    addDeletions(key, itr->second);
+  }
+
+  if (_filter.size() < _filter.capacity()) {
+    _filter.insert(key);
+  }
+  else {
+    growFilter();
+  }
+
+  if (_resultCache) {
+    _resultCache.emplace(_resultCache->maxSize()); // cached results might be missing the new word
+  }
+}
+
+void WordContainer::growFilter() {
+  my::blocked_bloom_filter filter{std::max<std::size_t>(1024, 2 * _map.size())};
+  for (const auto& entry : _map) {
+    filter.insert(entry.first);
+  }
+  _filter = std::move(filter);
+}
+
+void WordContainer::enableResultCache(std::size_t maxEntries) {
+  _resultCache.emplace(maxEntries);
+}
+
+void WordContainer::disableResultCache() {
+  _resultCache.reset();
 }
 
-bool WordContainer::contains(const std::string &str) {
+void WordContainer::enableSimilarIndex() {
+  _deletions.emplace(_map.get_allocator().resource());
+  for (const auto& entry : _map) {
+    addDeletions(entry.first, entry.second);
+  }
+}
+
+void WordContainer::disableSimilarIndex() {
+  _deletions.reset();
+}
+
+void WordContainer::addDeletions(key_t key, std::string_view word) {
+  for (std::size_t i = 0; i < word.size(); ++i) {
+    if (word.find(word[i]) == i) { // once per distinct char
+      _deletions->emplace(key / _charMap.prime(word[i]), key);
+    }
+  }
+}
+
+bool WordContainer::contains(std::string_view str) {
   auto key = getKey(str);
-  return _map.find(key) != _map.end();
+  return _filter.may_contain(key) && _map.find(key) != _map.end();
 }
 
-WordContainer::key_t WordContainer::getKey(const std::string &key) {
+WordContainer::key_t WordContainer::getKey(std::string_view key) {
     return std::accumulate(key.cbegin(), key.cend(), 1ull,
       [this](auto product, auto right) { return product * _charMap.prime(right); });
 }
@@ -27,19 +81,19 @@ WordContainer::key_t WordContainer::getKey(const std::string &key) {
  * The idea is to generate all permutation of keys (using primes from prime map)
  * -- this is done recursively in this function with the help of index
  * Following is quick dry run of what this method does
- *  => when index == 0, the vector contains only zeros
- *     -- get the current_prime by keys.at(index)
+ *  => when index == 0, the vector is empty
+ *     -- get the current_prime by keys[index]
  *     -- insert at 0th index (it is the first available index)
  *  => when index == 1, 0the index already has a prime.
- *     -- get the current_prime by keys.at(index)
+ *     -- get the current_prime by keys[index]
  *     -- insert at 1st index (it is the next available index)
  *     -- multiply prime at 0th index by current_prime and store at 2nd index
  *  => when index == 2, 0th to 3rd indices are already filled
- *     -- get the current_prime by keys.at(index)
+ *     -- get the current_prime by keys[index]
  *     -- insert at 4th index (it is the next available index)
  *     -- multiply primes from 0th to 3rd index by current_prime and store them at 5th to 6th indices respectively
  *  => when index == n, 0th to n^2-1 indices are already filled
- *     -- get the current_prime by keys.at(index)
+ *     -- get the current_prime by keys[index]
  *     -- insert at n^2th index (it is the next available index)
  *     -- multiply primes from 0th to n^2-1 indices by current_prime and store them at n^2+1th to n^(2+1)-2 indices respectively
  *
@@ -50,35 +104,29 @@ WordContainer::key_t WordContainer::getKey(const std::string &key) {
  * @param permutations
  */
 
-void WordContainer::getAllKeyPermutations(const std::vector<WordContainer::key_t> &keys, std::size_t index,
-                                                          std::vector<WordContainer::key_t>& permutations) {
+void WordContainer::getAllKeyPermutations(const WordContainer::keys_t &keys, std::size_t index,
+                                          WordContainer::permutations_t& permutations) {
   if (index == keys.size()) {
     return; // done with all keys!
   }
 
-  const auto prime = keys.at(index);
-
-  if (index != 0) {
+  const auto prime = keys[index];
 
-    auto begin = (1ull << index);
-    auto end = begin * 2 - 1;
+  // 0th to (2^index)-2 indices are already filled
+  const auto filled = permutations.size();
+  permutations.push_back(prime);
 
-    permutations.at(begin-1) = prime;
-
-    for (size_t i = 0; begin < end; ++i, ++begin) {
-      permutations.at(begin) = permutations.at(i) * prime;
-    }
-  }
-
-  else { // index == 0
-    permutations.at(index) = prime;
+  for (std::size_t i = 0; i < filled; ++i) {
+    permutations.push_back(permutations[i] * prime);
   }
 
   getAllKeyPermutations(keys, index+1, permutations);
 }
 
-std::vector<WordContainer::key_t> WordContainer::getKeys(const std::string &str) {
-  std::vector<WordContainer::key_t> keys{};
-  std::transform(str.begin(), str.end(), std::back_inserter(keys), [this](auto c){ return _charMap.prime(c); });
+WordContainer::keys_t WordContainer::getKeys(std::string_view str) {
+  keys_t keys{};
+  for (auto c : str) {
+    keys.push_back(_charMap.prime(c));
+  }
   return keys;
 }
\ No newline at end of file
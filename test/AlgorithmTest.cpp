@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include "../include/algorithm.h"
+
+#include <algorithm>
+#include <array>
+#include <list>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+struct AlgorithmTest : ::testing::Test {
+
+  // big enough to take the parallel path
+  static constexpr std::size_t large_size{my::detail::parallel_threshold * 2 + 3};
+
+  static constexpr std::array<int, 8> sorted_table() {
+    std::array<int, 8> table{5, 3, 8, 1, 9, 2, 7, 3};
+    my::sort(table.begin(), table.end());
+    return table;
+  }
+
+  std::vector<int> random_values(std::size_t size) {
+    std::uniform_int_distribution<int> dist{-1000, 1000};
+    std::vector<int> values(size);
+    std::generate(values.begin(), values.end(), [&] { return dist(_engine); });
+    return values;
+  }
+
+  std::mt19937 _engine{42};
+};
+
+TEST_F(AlgorithmTest, CompileTimeTest) {
+  constexpr auto table = sorted_table();
+  static_assert(table[0] == 1 && table[1] == 2 && table[2] == 3 && table[3] == 3);
+  static_assert(table[4] == 5 && table[5] == 7 && table[6] == 8 && table[7] == 9);
+
+  static_assert(*my::lower_bound(table.begin(), table.end(), 3) == 3);
+  static_assert(my::lower_bound(table.begin(), table.end(), 3) == table.begin() + 2);
+  static_assert(my::lower_bound(table.begin(), table.end(), 10) == table.end());
+  static_assert(my::lower_bound(table.begin(), table.end(), 7, std::less<>{}) == table.begin() + 5);
+
+  static_assert(my::count_if(table.begin(), table.end(), [](int v) { return v % 2 == 1; }) == 6);
+  static_assert(my::accumulate(table.begin(), table.end(), 0) == 38);
+  static_assert(my::accumulate(table.begin(), table.end(), 1, std::multiplies<>{}) == 45360);
+  static_assert(*my::find_if(table.begin(), table.end(), [](int v) { return v > 4; }) == 5);
+
+  constexpr auto squares = [] {
+    std::array<int, 4> values{};
+    my::iota(values.begin(), values.end(), 1);
+    my::transform(values.begin(), values.end(), values.begin(), [](int v) { return v * v; });
+    return values;
+  }();
+  static_assert(squares[0] == 1 && squares[1] == 4 && squares[2] == 9 && squares[3] == 16);
+
+  // basic_string iterators only for character types, any value type for vector
+  static_assert(my::detail::is_contiguous_v<std::string::const_iterator>);
+  static_assert(my::detail::is_contiguous_v<std::u32string::iterator>);
+  static_assert(my::detail::is_contiguous_v<std::vector<std::string>::iterator>);
+  static_assert(!my::detail::is_contiguous_v<std::list<std::string>::iterator>);
+  static_assert(!my::detail::is_contiguous_v<std::vector<bool>::iterator>);
+}
+
+TEST_F(AlgorithmTest, RuntimeMatchesStdTest) {
+  for (auto size : {std::size_t{0}, std::size_t{1}, std::size_t{7}, std::size_t{1000}, large_size}) {
+    auto values = random_values(size);
+    const auto is_positive = [](int v) { return v > 0; };
+
+    EXPECT_EQ(std::count_if(values.begin(), values.end(), is_positive),
+              my::count_if(values.begin(), values.end(), is_positive));
+    EXPECT_EQ(std::accumulate(values.begin(), values.end(), 0ll),
+              my::accumulate(values.begin(), values.end(), 0ll));
+    EXPECT_EQ(std::find_if(values.begin(), values.end(), is_positive),
+              my::find_if(values.begin(), values.end(), is_positive));
+
+    std::vector<int> expected(size), transformed(size);
+    std::transform(values.begin(), values.end(), expected.begin(), [](int v) { return v * 3; });
+    my::transform(values.begin(), values.end(), transformed.begin(), [](int v) { return v * 3; });
+    EXPECT_EQ(expected, transformed);
+
+    auto sorted = values;
+    my::sort(sorted.begin(), sorted.end());
+    EXPECT_TRUE(std::is_sorted(sorted.begin(), sorted.end()));
+
+    my::sort(values.begin(), values.end(), std::greater<>{});
+    EXPECT_TRUE(std::is_sorted(values.begin(), values.end(), std::greater<>{}));
+
+    for (int probe : {-1001, -500, 0, 1, 500, 1001}) {
+      EXPECT_EQ(std::lower_bound(sorted.begin(), sorted.end(), probe),
+                my::lower_bound(sorted.begin(), sorted.end(), probe));
+    }
+  }
+}
+
+TEST_F(AlgorithmTest, NonContiguousRangeTest) {
+  const std::list<int> values{4, 1, 3, 2};
+  EXPECT_EQ(10, my::accumulate(values.begin(), values.end(), 0));
+  EXPECT_EQ(2, my::count_if(values.begin(), values.end(), [](int v) { return v > 2; }));
+  EXPECT_EQ(std::next(values.begin(), 2), my::find_if(values.begin(), values.end(), [](int v) { return v == 3; }));
+
+  // bits of vector<bool> are behind a proxy iterator, not contiguous bools
+  const std::vector<bool> bits{true, false, true, true};
+  EXPECT_EQ(3, my::accumulate(bits.begin(), bits.end(), 0));
+  EXPECT_EQ(1, my::count_if(bits.begin(), bits.end(), [](bool v) { return !v; }));
+
+  // floating point values are always summed in order
+  const std::vector<double> doubles{1e16, 1.0, -1e16, 1.0};
+  EXPECT_EQ(std::accumulate(doubles.begin(), doubles.end(), 0.0), my::accumulate(doubles.begin(), doubles.end(), 0.0));
+}
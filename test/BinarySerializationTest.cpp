@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include "../include/BinarySerialization.h"
+#include "../include/Person.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct BinarySerializationTest : ::testing::Test {
+
+  struct Employee {
+    auto reflect() const { return std::tie(_id, _person, _salary, _manager); }
+    auto mut_reflect() { return std::tie(_id, _person, _salary, _manager); }
+
+    std::int32_t _id{};
+    Person _person{};
+    double _salary{};
+    bool _manager{};
+  };
+
+  // decoding into views doesn't copy the strings
+  struct PersonView {
+    auto reflect() const { return std::tie(_fName, _sName); }
+    auto mut_reflect() { return std::tie(_fName, _sName); }
+
+    std::string_view _fName;
+    std::string_view _sName;
+  };
+
+  std::vector<char> _buffer = std::vector<char>(1024);
+};
+
+TEST_F(BinarySerializationTest, WireFormatTest) {
+  const auto written = my::serialize(Person{"ab", "c"}, _buffer.data(), _buffer.size());
+  EXPECT_EQ(written, my::binary_size(Person{"ab", "c"}));
+
+  // length prefixes are 4 bytes little-endian
+  const std::vector<char> expected{2, 0, 0, 0, 'a', 'b', 1, 0, 0, 0, 'c'};
+  EXPECT_EQ(expected, std::vector<char>(_buffer.begin(), _buffer.begin() + written));
+
+  my::binary_writer writer{_buffer.data(), _buffer.size()};
+  writer.write(std::uint16_t{0x0102}).write(std::int32_t{-2});
+  EXPECT_EQ(6, writer.size());
+  EXPECT_EQ(0x02, _buffer[0]);
+  EXPECT_EQ(0x01, _buffer[1]);
+  EXPECT_EQ(std::string(4, '\xff').replace(0, 1, 1, '\xfe'), std::string(_buffer.begin() + 2, _buffer.begin() + 6));
+}
+
+TEST_F(BinarySerializationTest, RoundTripTest) {
+  // spaces can't be round tripped through operator<< and operator>>
+  const Person person{"Anil Kumar", "Some Surname"};
+  const auto written = my::serialize(person, _buffer.data(), _buffer.size());
+
+  Person decoded{};
+  EXPECT_EQ(written, my::deserialize(decoded, _buffer.data(), written));
+  EXPECT_EQ(person, decoded);
+
+  Employee employee{};
+  employee._id = -42;
+  employee._person = person;
+  employee._salary = 1234.5;
+  employee._manager = true;
+
+  const auto employee_size = my::serialize(employee, _buffer.data(), _buffer.size());
+  EXPECT_EQ(4 + written + 8 + 1, employee_size);
+
+  Employee decoded_employee{};
+  my::deserialize(decoded_employee, _buffer.data(), employee_size);
+  EXPECT_EQ(employee, decoded_employee);
+}
+
+TEST_F(BinarySerializationTest, ZeroCopyViewTest) {
+  const auto written = my::serialize(Person{"Anil", "Kumar"}, _buffer.data(), _buffer.size());
+
+  PersonView view{};
+  my::deserialize(view, _buffer.data(), written);
+  EXPECT_EQ("Anil", view._fName);
+  EXPECT_EQ("Kumar", view._sName);
+  EXPECT_EQ(_buffer.data() + 4, view._fName.data());
+}
+
+TEST_F(BinarySerializationTest, MultipleRecordsTest) {
+  const std::vector<Person> people{Person{"a", "b"}, Person{"", ""}, Person{"first", "second"}};
+
+  my::binary_writer writer{_buffer.data(), _buffer.size()};
+  for (const auto& person : people) {
+    writer.write(person);
+  }
+
+  my::binary_reader reader{_buffer.data(), writer.size()};
+  std::vector<Person> decoded{};
+  while (!reader.empty()) {
+    decoded.push_back(reader.read<Person>());
+  }
+  EXPECT_EQ(people, decoded);
+}
+
+TEST_F(BinarySerializationTest, BufferBoundsTest) {
+  const Person person{"Anil", "Kumar"};
+  const auto size = my::binary_size(person);
+  EXPECT_THROW(my::serialize(person, _buffer.data(), size - 1), std::runtime_error);
+
+  my::serialize(person, _buffer.data(), size);
+  Person decoded{};
+  EXPECT_THROW(my::deserialize(decoded, _buffer.data(), size - 1), std::runtime_error);
+
+  // a corrupt length prefix must not read beyond the buffer
+  _buffer[3] = '\x7f';
+  EXPECT_THROW(my::deserialize(decoded, _buffer.data(), size), std::runtime_error);
+}
@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+
+#include "../include/BloomFilter.h"
+
+#include <random>
+#include <unordered_set>
+
+struct BloomFilterTest : ::testing::Test {
+  std::mt19937_64 _engine{42};
+};
+
+TEST_F(BloomFilterTest, EmptyTest) {
+  const my::blocked_bloom_filter filter{};
+  EXPECT_EQ(0, filter.size());
+  EXPECT_EQ(32, filter.memory()); // a single block
+  for (std::uint64_t key = 0; key < 1000; ++key) {
+    EXPECT_FALSE(filter.may_contain(key));
+  }
+}
+
+TEST_F(BloomFilterTest, NoFalseNegativesTest) {
+  constexpr std::size_t count{100000};
+  my::blocked_bloom_filter filter{count};
+  EXPECT_EQ(count * 2, filter.memory()); // 16 bits per key
+
+  std::unordered_set<std::uint64_t> keys{};
+  while (keys.size() < count) {
+    keys.insert(_engine());
+  }
+  for (auto key : keys) {
+    filter.insert(key);
+  }
+  EXPECT_EQ(count, filter.size());
+
+  for (auto key : keys) {
+    EXPECT_TRUE(filter.may_contain(key));
+  }
+
+  // ~0.5% expected
+  std::size_t falsePositives{0};
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto key = _engine();
+    falsePositives += (keys.count(key) == 0 && filter.may_contain(key));
+  }
+  EXPECT_GT(count / 100, falsePositives);
+}
+
+TEST_F(BloomFilterTest, SequentialKeysTest) {
+  // keys sharing most of their bits (like products of small primes) still spread over the blocks
+  my::blocked_bloom_filter filter{1000};
+  for (std::uint64_t key = 0; key < 1000; ++key) {
+    filter.insert(key * 1024);
+  }
+  std::size_t falsePositives{0};
+  for (std::uint64_t key = 0; key < 100000; ++key) {
+    EXPECT_TRUE(key >= 1000 || filter.may_contain(key * 1024));
+    falsePositives += (key % 1024 != 0 && filter.may_contain(key));
+  }
+  EXPECT_GT(1000, falsePositives);
+}
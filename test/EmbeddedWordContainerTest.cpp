@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+
+#include "../include/EmbeddedWordContainer.h"
+#include "../include/WordContainer.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+struct EmbeddedWordContainerTest : ::testing::Test {
+  static constexpr EmbeddedWordContainer dictionary{"wo", "wom", "me", "men", "man", "woman", "women", "nemow", "on"};
+
+  template <std::size_t WordCount, std::size_t BlobSize>
+  static constexpr std::size_t count(const EmbeddedWordContainer<WordCount, BlobSize>& container_, std::string_view query_) {
+    struct counter {
+      std::size_t* count;
+      constexpr counter& operator=(std::string_view) {
+        ++*count;
+        return *this;
+      }
+    };
+
+    std::size_t result{0};
+    container_.get(query_, counter{&result});
+    return result;
+  }
+};
+
+TEST_F(EmbeddedWordContainerTest, CompileTimeTest) {
+  static_assert(dictionary.size() == 8); // "nemow" is an anagram of "women"
+  static_assert(dictionary.contains("women"));
+  static_assert(dictionary.contains("nemow"));
+  static_assert(dictionary.contains("mow"));
+  static_assert(!dictionary.contains("mew"));
+  static_assert(count(dictionary, "women") == 6);
+  static_assert(count(dictionary, "xyz") == 0);
+}
+
+TEST_F(EmbeddedWordContainerTest, SameAsWordContainerTest) {
+  WordContainer wc{};
+  for (auto word : {"wo", "wom", "me", "men", "man", "woman", "women", "nemow", "on"}) {
+    wc.add(word);
+  }
+
+  for (std::string_view query : {"", "o", "women", "wonxxxxxme", "moowen", "owomwenn", "man"}) {
+    std::vector<std::string> expected{};
+    wc.get(query, std::back_inserter(expected));
+
+    std::vector<std::string_view> words{};
+    dictionary.get(query, std::back_inserter(words));
+    EXPECT_EQ(expected, std::vector<std::string>(words.begin(), words.end())) << query;
+  }
+}
+
+TEST_F(EmbeddedWordContainerTest, EmptyTest) {
+  static constexpr EmbeddedWordContainer empty{};
+  static_assert(empty.size() == 0);
+  static_assert(!empty.contains("a"));
+  static_assert(count(empty, "abc") == 0);
+}
+
+TEST_F(EmbeddedWordContainerTest, InvalidWordTest) {
+  EXPECT_THROW(EmbeddedWordContainer("toolongword"), std::runtime_error);
+  EXPECT_THROW(EmbeddedWordContainer("a1"), std::runtime_error);
+}
@@ -1,6 +1,16 @@
 #include <gtest/gtest.h>
 #include <string>
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <memory_resource>
+#include <mutex>
 #include <random>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "../include/LRUCache.h"
 
@@ -67,4 +77,296 @@ TEST_F(LRUCacheTest, LatestAccessTest) {
     _lruCache.get(randNum);
     EXPECT_EQ(randNum, std::prev(_lruCache.end())->first);
   }
-}
\ No newline at end of file
+}
+
+struct LRUCacheSnapshotTest : public LRUCacheTest {
+  void SetUp() override {
+    LRUCacheTest::SetUp();
+    for (std::size_t i = 0; i < _maxSize; ++i) {
+      _lruCache.insert(i, std::to_string(i));
+    }
+    for (int i = 0; i < 100; ++i) {
+      _lruCache.get(getRandomNum());
+    }
+    _lruCache.saveSnapshot(_path);
+  }
+
+  void TearDown() override {
+    std::remove(_path.c_str());
+  }
+
+  template <typename Cache>
+  std::vector<std::pair<int, std::string>> entries(Cache& cache_) {
+    return {cache_.begin(), cache_.end()};
+  }
+
+  const std::string _path{(std::filesystem::temp_directory_path() / "LRUCacheSnapshotTest.snapshot").string()};
+};
+
+TEST_F(LRUCacheSnapshotTest, LoadTest) {
+  LRUCache<int, std::string> restored{_maxSize};
+  EXPECT_EQ(_maxSize, restored.loadSnapshot(_path));
+  EXPECT_EQ(entries(_lruCache), entries(restored)); // same recency order
+
+  // only the most recently used ones, when there is less room
+  LRUCache<int, std::string> smaller{2};
+  EXPECT_EQ(2, smaller.loadSnapshot(_path));
+  EXPECT_EQ(std::prev(_lruCache.end(), 2)->first, smaller.begin()->first);
+  EXPECT_EQ(std::prev(_lruCache.end())->first, std::prev(smaller.end())->first);
+
+  EXPECT_THROW(restored.loadSnapshot("missing.snapshot"), std::runtime_error);
+}
+
+TEST_F(LRUCacheSnapshotTest, RestoreInBackgroundTest) {
+  LRUCache<int, std::string> restored{_maxSize};
+  restored.restoreSnapshot(_path, 2);
+  EXPECT_EQ(_maxSize, restored.finishRestore());
+  EXPECT_FALSE(restored.restoring());
+  EXPECT_EQ(entries(_lruCache), entries(restored));
+
+  // serves hits while restoring
+  LRUCache<int, std::string> serving{_maxSize};
+  serving.restoreSnapshot(_path, 1);
+  const auto mostRecent = std::prev(_lruCache.end())->first;
+  while (serving.get(mostRecent) == serving.end()) {
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(std::to_string(mostRecent), serving.get(mostRecent)->second);
+  serving.finishRestore();
+  EXPECT_EQ(_maxSize, serving.size());
+}
+
+TEST_F(LRUCacheSnapshotTest, RestoreIntoLiveCacheTest) {
+  // entries inserted meanwhile are more recent than the restored ones, and aren't overwritten
+  LRUCache<int, std::string> restored{_maxSize};
+  restored.insert(0, "live");
+  restored.insert(100, "live");
+  restored.restoreSnapshot(_path);
+  restored.finishRestore();
+
+  auto expected = entries(_lruCache);
+  expected.erase(std::find_if(expected.begin(), expected.end(), [](const auto& e_) { return e_.first == 0; }));
+  expected.erase(expected.begin()); // the least recently used one doesn't fit
+  expected.emplace_back(0, "live");
+  expected.emplace_back(100, "live");
+  EXPECT_EQ(expected, entries(restored));
+}
+
+TEST_F(LRUCacheSnapshotTest, CorruptedSnapshotTest) {
+  LRUCache<int, std::string> restored{_maxSize};
+  EXPECT_THROW(restored.restoreSnapshot("missing.snapshot"), std::runtime_error);
+
+  // header is checked right away
+  std::string bytes{};
+  {
+    std::ifstream file{_path, std::ios::binary};
+    bytes.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+  }
+  auto rewrite = [this](const std::string& bytes_) {
+    std::ofstream file{_path, std::ios::binary | std::ios::trunc};
+    file << bytes_;
+  };
+
+  rewrite("LRUS garbage");
+  EXPECT_THROW(restored.loadSnapshot(_path), std::runtime_error);
+  EXPECT_THROW(restored.restoreSnapshot(_path), std::runtime_error);
+
+  // rest of it, only once it's decoded
+  rewrite(bytes.substr(0, bytes.size() - 1));
+  EXPECT_THROW(restored.loadSnapshot(_path), std::runtime_error);
+  restored.restoreSnapshot(_path);
+  EXPECT_THROW(restored.finishRestore(), std::runtime_error);
+  EXPECT_FALSE(restored.restoring());
+  EXPECT_EQ(0, restored.size());
+}
+
+TEST_F(LRUCacheTest, EvictionListenerTest) {
+  std::vector<int> evicted{};
+  _lruCache.setEvictionListener([&evicted](const auto& entry_) {
+    EXPECT_EQ(std::to_string(entry_.first), entry_.second);
+    evicted.push_back(entry_.first);
+  });
+
+  for (int i = 0; i < 20; ++i) {
+    _lruCache.insert(i, std::to_string(i));
+  }
+  _lruCache.get(15);
+  _lruCache.insert(20, "20");
+  _lruCache.erase(17); // erasing isn't evicting
+
+  const std::vector<int> expected{0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 16};
+  EXPECT_EQ(expected, evicted);
+}
+
+TEST_F(LRUCacheTest, BackgroundReclaimTest) {
+  // records where the values are destroyed
+  struct Tracked {
+    explicit Tracked(std::vector<std::thread::id>& destroyedOn_) : destroyedOn(&destroyedOn_) {}
+    Tracked(Tracked&& other_) noexcept : destroyedOn(std::exchange(other_.destroyedOn, nullptr)) {}
+    ~Tracked() {
+      if (destroyedOn != nullptr) {
+        std::lock_guard<std::mutex> lock{mutex()};
+        destroyedOn->push_back(std::this_thread::get_id());
+      }
+    }
+    static std::mutex& mutex() {
+      static std::mutex m{};
+      return m;
+    }
+    std::vector<std::thread::id>* destroyedOn;
+  };
+
+  std::vector<std::thread::id> destroyedOn{};
+  {
+    LRUCache<int, Tracked> cache{5};
+    std::size_t evicted{0};
+    cache.setEvictionListener([&evicted](const auto&) { ++evicted; });
+    cache.reclaimInBackground(4);
+
+    for (int i = 0; i < 25; ++i) {
+      cache.insert(i, Tracked{destroyedOn});
+    }
+    EXPECT_EQ(20, evicted);
+    EXPECT_EQ(5, cache.size());
+    for (int i = 20; i < 25; ++i) {
+      EXPECT_NE(cache.end(), cache.get(i));
+    }
+  }
+
+  // all the evicted ones are destroyed by the reclaimer, rest of them by the cache itself
+  ASSERT_EQ(25, destroyedOn.size());
+  const auto onThisThread = std::count(destroyedOn.begin(), destroyedOn.end(), std::this_thread::get_id());
+  EXPECT_EQ(5, onThisThread);
+}
+
+TEST_F(LRUCacheTest, CopyTest) {
+  for (int i = 0; i < 10; ++i) {
+    _lruCache.insert(i, std::to_string(i));
+  }
+  _lruCache.reclaimInBackground(2);
+  _lruCache.get(6);
+
+  // same entries in the same order, in nodes of its own
+  auto copy = _lruCache;
+  EXPECT_TRUE(std::equal(_lruCache.begin(), _lruCache.end(), copy.begin(), copy.end()));
+  copy.get(5);
+  EXPECT_EQ(5, std::prev(copy.end())->first);
+  EXPECT_EQ(6, std::prev(_lruCache.end())->first);
+
+  // evicts on its own, without the reclaimer of the original
+  copy.insert(10, "10");
+  EXPECT_EQ(copy.end(), copy.get(7));
+  EXPECT_NE(_lruCache.end(), _lruCache.get(7));
+
+  LRUCache<int, std::string> assigned{1};
+  assigned = copy;
+  EXPECT_EQ(copy.maxSize(), assigned.maxSize());
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), assigned.begin(), assigned.end()));
+  assigned.get(8);
+  EXPECT_EQ(10, std::prev(copy.end())->first);
+}
+
+TEST_F(LRUCacheTest, MultiGetTest) {
+  LRUCache<int, std::string> sequential{_maxSize};
+  for (std::size_t i = 0; i < _maxSize; ++i) {
+    _lruCache.insert(i, std::to_string(i));
+    sequential.insert(i, std::to_string(i));
+  }
+
+  const std::vector<int> keys{3, 7, 1, 3, 0};
+  std::vector<LRUCache<int, std::string>::iterator> found{};
+  _lruCache.multiGet(keys.begin(), keys.end(), std::back_inserter(found));
+
+  ASSERT_EQ(keys.size(), found.size());
+  EXPECT_EQ(_lruCache.end(), found[1]);
+  for (std::size_t i : {0, 2, 3, 4}) {
+    EXPECT_EQ(keys[i], found[i]->first);
+  }
+
+  // same recency order as calling get() one by one
+  for (auto key : keys) {
+    sequential.get(key);
+  }
+  EXPECT_TRUE(std::equal(sequential.begin(), sequential.end(), _lruCache.begin(), _lruCache.end()));
+}
+
+TEST_F(LRUCacheTest, MultiInsertTest) {
+  LRUCache<int, std::string> sequential{_maxSize};
+  for (int i = 0; i < 3; ++i) {
+    _lruCache.insert(i, std::to_string(i));
+    sequential.insert(i, std::to_string(i));
+  }
+
+  // existing keys, a duplicate in the batch, and more than there is room for
+  const std::vector<std::pair<int, std::string>> pairs{{5, "5"}, {1, "one"}, {6, "6"}, {5, "five"}, {7, "7"}};
+  std::vector<int> evicted{};
+  _lruCache.setEvictionListener([&evicted](const auto& entry_) { evicted.push_back(entry_.first); });
+  EXPECT_EQ(7, _lruCache.multiInsert(pairs.begin(), pairs.end())->first);
+
+  for (const auto& pair : pairs) {
+    sequential.insert(pair.first, pair.second);
+  }
+  EXPECT_EQ(_maxSize, _lruCache.size());
+  EXPECT_TRUE(std::equal(sequential.begin(), sequential.end(), _lruCache.begin(), _lruCache.end()));
+  EXPECT_EQ("1", _lruCache.get(1)->second);
+  EXPECT_EQ("5", _lruCache.get(5)->second);
+  EXPECT_EQ((std::vector<int>{0}), evicted);
+
+  EXPECT_EQ(_lruCache.end(), _lruCache.multiInsert(pairs.end(), pairs.end()));
+}
+
+namespace {
+  // counts the bytes currently allocated from it, thread safe as new_delete_resource is
+  struct counting_resource : std::pmr::memory_resource {
+    std::atomic<std::size_t> allocated{0};
+
+    void* do_allocate(std::size_t bytes_, std::size_t alignment_) override {
+      allocated += bytes_;
+      return std::pmr::new_delete_resource()->allocate(bytes_, alignment_);
+    }
+
+    void do_deallocate(void* ptr_, std::size_t bytes_, std::size_t alignment_) override {
+      allocated -= bytes_;
+      std::pmr::new_delete_resource()->deallocate(ptr_, bytes_, alignment_);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other_) const noexcept override {
+      return this == &other_;
+    }
+  };
+}
+
+TEST_F(LRUCacheTest, MemoryResourceTest) {
+  counting_resource resource{};
+  {
+    PmrLRUCache<int, std::string> cache{_maxSize, &resource};
+    EXPECT_EQ(&resource, cache.get_allocator().resource());
+
+    for (int i = 0; i < 10; ++i) {
+      cache.insert(i, std::to_string(i));
+    }
+    EXPECT_GT(resource.allocated, 0);
+    EXPECT_EQ(_maxSize, cache.size());
+    EXPECT_EQ("9", cache.get(9)->second);
+    EXPECT_EQ(cache.end(), cache.get(0));
+
+    // evicted nodes go back to the resource from the background thread
+    cache.reclaimInBackground(1);
+    cache.insert(10, "10");
+    EXPECT_EQ(cache.end(), cache.get(5));
+  }
+  EXPECT_EQ(0, resource.allocated);
+}
+
+TEST_F(LRUCacheSnapshotTest, MemoryResourceRestoreTest) {
+  std::pmr::synchronized_pool_resource pool{};
+  PmrLRUCache<int, std::string> loaded{_maxSize, &pool};
+  EXPECT_EQ(_maxSize, loaded.loadSnapshot(_path));
+  EXPECT_EQ(entries(_lruCache), entries(loaded));
+
+  // batches decoded on the loader thread are spliced into the cache, so they come from the same resource
+  PmrLRUCache<int, std::string> restored{_maxSize, &pool};
+  restored.restoreSnapshot(_path, 1);
+  EXPECT_EQ(_maxSize, restored.finishRestore());
+  EXPECT_EQ(entries(_lruCache), entries(restored));
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include "../include/Pattern.h"
+
+#include <iterator>
+#include <random>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+// same expectations as in RegexUseTest, with the patterns compiled at compile time
+struct PatternTest : ::testing::Test {
+  using views = std::vector<std::string_view>;
+
+  static constexpr my::pattern<> sep_pattern{"[[:s:]]*[,;.:][[:s:]]*"};
+  static constexpr my::tag_pattern tag{};
+
+  const views expected{"entity1", "entity2", "entity3", "entity4", "entity5", "entity6"};
+};
+
+// everything happens at compile time
+static_assert(PatternTest::sep_pattern.state_count() == 3); // dead, before and after the separator
+static_assert(PatternTest::sep_pattern.match(" ,  "));
+static_assert(!PatternTest::sep_pattern.match(" , , "));
+static_assert(PatternTest::sep_pattern.search("entity1 ; entity2").str() == " ; ");
+static_assert(PatternTest::tag.match("<h1>the value<h1>")[2] == "the value");
+
+TEST_F(PatternTest, BasicSearchTest) {
+  const std::string prefix{"tag starts now: "};
+  const std::string suffix{": that ended the tags"};
+  const std::string html_tag{"<h1>the value<h1>"};
+  const std::string source{prefix + html_tag + suffix};
+
+  const auto match = tag.search(source);
+  EXPECT_TRUE(match);
+  EXPECT_EQ(4, match.size());
+  EXPECT_EQ(html_tag, match.str());
+  EXPECT_EQ(prefix, match.prefix());
+  EXPECT_EQ(suffix, match.suffix());
+
+  EXPECT_EQ("h1", match[1]);
+  EXPECT_EQ("the value", match[2]);
+  EXPECT_EQ("h1", match[3]);
+}
+
+TEST_F(PatternTest, BasicMatchTest) {
+  const std::string html_tag {"<h1>the value<h1>"};
+
+  const auto match = tag.match(html_tag);
+  EXPECT_TRUE(match);
+  EXPECT_EQ(4, match.size());
+  EXPECT_EQ(html_tag, match.str());
+  EXPECT_EQ(0, match.prefix().length());
+  EXPECT_EQ(0, match.suffix().length());
+
+  EXPECT_EQ("h1", match[1]);
+  EXPECT_EQ("the value", match[2]);
+  EXPECT_EQ("h1", match[3]);
+
+  EXPECT_FALSE(tag.match("<h1>the value<h2>"));
+  EXPECT_FALSE(tag.match("x<h1>the value<h1>"));
+  EXPECT_EQ(0, tag.match("<h1>the\nvalue<h1>").size());
+}
+
+TEST_F(PatternTest, BasicTokenTest) {
+  const std::string source{"entity1, entity2; entity3: entity4. entity5, entity6"};
+  EXPECT_EQ(expected, sep_pattern.split(source).to_vector());
+}
+
+TEST_F(PatternTest, TokenTestForSepAtEnd) {
+  const std::string source_c{"entity1,    entity2; entity3: entity4. entity5, entity6 ,  "};
+  EXPECT_EQ(expected, sep_pattern.split(source_c).to_vector());
+}
+
+TEST_F(PatternTest, TokenTestForSepAtBeginning) {
+  // same as std::sregex_token_iterator, there is an empty token at the beginning
+  const std::string source_c{" ,  entity1,    entity2; entity3: entity4. entity5, entity6"};
+  auto expected_copy = expected;
+  expected_copy.insert(expected_copy.begin(), "");
+  EXPECT_EQ(expected_copy, sep_pattern.split(source_c).to_vector());
+
+  // tokens are kept in the iterators themselves
+  static_assert(std::is_same_v<std::iterator_traits<my::pattern<>::token_iterator>::iterator_category, std::input_iterator_tag>);
+}
+
+TEST_F(PatternTest, SyntaxTest) {
+  constexpr my::pattern<> number{"[+-]?\\d+\\.?[[:digit:]]*"};
+  EXPECT_TRUE(number.match("-12.50"));
+  EXPECT_TRUE(number.match("7"));
+  EXPECT_FALSE(number.match("-.5"));
+  EXPECT_FALSE(number.match(""));
+  EXPECT_EQ("42", number.search("answer: 42!").str());
+
+  constexpr my::pattern<> not_space{"[^[:s:]a-c]+"};
+  EXPECT_EQ("xyz", not_space.search("abc xyz").str());
+
+  // '.' doesn't match line terminators
+  constexpr my::pattern<> any{"a.c"};
+  EXPECT_TRUE(any.match("a-c"));
+  EXPECT_FALSE(any.match("a\nc"));
+
+  EXPECT_FALSE(my::pattern<>{"x"}.search("abc"));
+  EXPECT_THROW(my::pattern<>{"(a)"}, std::runtime_error);
+  EXPECT_THROW(my::pattern<>{"a|b"}, std::runtime_error);
+  EXPECT_THROW(my::pattern<>{"*a"}, std::runtime_error);
+  EXPECT_THROW(my::pattern<>{"[a-"}, std::runtime_error);
+  EXPECT_THROW(my::pattern<>{"[[:nope:]]"}, std::runtime_error);
+  EXPECT_THROW(my::pattern<>{"<(.*)>\\1"}, std::runtime_error);
+  EXPECT_THROW(my::pattern<2>{"ab"}, std::runtime_error); // needs 4 states
+}
+
+TEST_F(PatternTest, SameAsRegexTest) {
+  const std::regex regex_sep{"[[:s:]]*[,;.:][[:s:]]*"};
+  const std::regex regex_tag{"<(.*)>(.*)<(\\1)>"};
+
+  std::mt19937 generator{42};
+  const std::string_view alphabet{"ab1 ,;.:<>\t"};
+  std::uniform_int_distribution<std::size_t> letter{0, alphabet.size() - 1};
+  std::uniform_int_distribution<std::size_t> length{0, 40};
+
+  for (int i = 0; i < 2000; ++i) {
+    std::string source{};
+    for (auto size = length(generator); size > 0; --size) {
+      source += alphabet[letter(generator)];
+    }
+
+    views regex_tokens{};
+    for (std::sregex_token_iterator itr{source.begin(), source.end(), regex_sep, -1}, end{}; itr != end; ++itr) {
+      regex_tokens.emplace_back(source.data() + (itr->first - source.begin()), itr->length());
+    }
+    EXPECT_EQ(regex_tokens, sep_pattern.split(source).to_vector()) << source;
+
+    std::smatch regex_match{};
+    const auto match = tag.search(source);
+    ASSERT_EQ(std::regex_search(source, regex_match, regex_tag), static_cast<bool>(match)) << source;
+    if (match) {
+      EXPECT_EQ(regex_match.position(), match.position()) << source;
+      for (std::size_t group = 0; group < 4; ++group) {
+        EXPECT_EQ(regex_match[group].str(), match[group]) << source;
+      }
+    }
+    EXPECT_EQ(std::regex_match(source, regex_tag), static_cast<bool>(tag.match(source))) << source;
+  }
+}
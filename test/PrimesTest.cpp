@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include "../include/Primes.h"
+
+#include <vector>
+
+struct PrimesTest : ::testing::Test {
+
+  static std::vector<std::size_t> trial_division_primes(std::size_t count) {
+    std::vector<std::size_t> primes{};
+    for (std::size_t num = 2; primes.size() != count; ++num) {
+      bool is_prime{true};
+      for (auto prime : primes) {
+        if (prime * prime > num) {
+          break;
+        }
+        if (num % prime == 0) {
+          is_prime = false;
+          break;
+        }
+      }
+      if (is_prime) {
+        primes.push_back(num);
+      }
+    }
+    return primes;
+  }
+};
+
+TEST_F(PrimesTest, UpperBoundTest) {
+  static_assert(my::log2_ceil(1) == 0);
+  static_assert(my::log2_ceil(2) == 1);
+  static_assert(my::log2_ceil(5) == 3);
+  static_assert(my::log2_ceil(1024) == 10);
+
+  const auto primes = trial_division_primes(2000);
+  for (std::size_t n = 1; n <= primes.size(); ++n) {
+    EXPECT_LT(primes[n - 1], my::nth_prime_upper_bound(n));
+  }
+}
+
+TEST_F(PrimesTest, SmallTableTest) {
+  static_assert(my::make_prime_table<0>().empty());
+  static_assert(my::make_prime_table<1>()[0] == 2);
+
+  constexpr auto table = my::make_prime_table<10>();
+  static_assert(table[0] == 2 && table[1] == 3 && table[2] == 5 && table[3] == 7 && table[4] == 11);
+  static_assert(table[5] == 13 && table[6] == 17 && table[7] == 19 && table[8] == 23 && table[9] == 29);
+}
+
+/**
+ * Compile time budget: these must stay within the default constexpr limits of the compiler
+ * (e.g. -fconstexpr-ops-limit for gcc and -fconstexpr-steps for clang)
+ */
+TEST_F(PrimesTest, LargeCompileTimeTableTest) {
+  constexpr auto table = my::make_prime_table<5000>();
+  static_assert(table[999] == 7919);
+  static_assert(table[4999] == 48611);
+
+  const auto expected = trial_division_primes(table.size());
+  EXPECT_TRUE(std::equal(table.begin(), table.end(), expected.begin(), expected.end()));
+}
@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include "../include/Person.h"
+#include "../include/RecordFile.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct RecordFileTest : ::testing::Test {
+
+  struct Account {
+    auto reflect() const { return std::tie(_owner, _id, _balance, _active); }
+    auto mut_reflect() { return std::tie(_owner, _id, _balance, _active); }
+
+    Person _owner;
+    long _id;
+    double _balance;
+    bool _active;
+  };
+
+  void SetUp() override {
+    for (int i = 0; i < 1000; ++i) {
+      _people.emplace_back("first" + std::to_string(i), "second" + std::to_string(i % 7));
+    }
+  }
+
+  void TearDown() override {
+    std::remove(_path.c_str());
+  }
+
+  std::vector<Person> _people{};
+  const std::string _path{(std::filesystem::temp_directory_path() / "RecordFileTest.txt").string()};
+};
+
+TEST_F(RecordFileTest, WriteReadRoundTripTest) {
+  {
+    my::record_file_writer<Person> writer{_path, 128};
+    writer.write(_people.begin(), _people.end());
+  }
+
+  for (std::size_t threads : {1, 3, 8}) {
+    EXPECT_EQ(_people, my::read_record_file<Person>(_path, threads));
+  }
+}
+
+TEST_F(RecordFileTest, WriteErrorTest) {
+  if (!std::filesystem::exists("/dev/full")) {
+    GTEST_SKIP() << "needs /dev/full";
+  }
+
+  // opens fine, but every write fails with no space left on the device
+  my::record_file_writer<Person> writer{"/dev/full", 128};
+  EXPECT_THROW(writer.write(_people.begin(), _people.end()), std::runtime_error);
+  writer.write(_people.front());
+  EXPECT_THROW(writer.flush(), std::runtime_error);
+}
+
+TEST_F(RecordFileTest, SameFormatAsOperatorTest) {
+  std::ostringstream os{};
+  for (const auto& person : _people) {
+    os << person << '\n';
+  }
+
+  EXPECT_EQ(_people, my::parse_records<Person>(os.str(), 5));
+
+  // and records can be read back by operator>> as well
+  {
+    my::record_file_writer<Person> writer{_path};
+    writer.write(_people.begin(), _people.end());
+  }
+  std::ifstream file{_path};
+  Person person{};
+  file >> person;
+  EXPECT_EQ(_people.front(), person);
+}
+
+TEST_F(RecordFileTest, NestedRecordsTest) {
+  const std::string text{"Anil Kumar 1 10.5 1\n\n  Bob Smith -2 0 0 \r\nCarl Jones 3 -1e-05 1"};
+  const auto accounts = my::parse_records<Account>(text, 2);
+
+  ASSERT_EQ(3, accounts.size());
+  EXPECT_EQ(Person("Anil", "Kumar"), accounts[0]._owner);
+  EXPECT_EQ(1, accounts[0]._id);
+  EXPECT_EQ(10.5, accounts[0]._balance);
+  EXPECT_TRUE(accounts[0]._active);
+  EXPECT_EQ(Person("Bob", "Smith"), accounts[1]._owner);
+  EXPECT_EQ(-2, accounts[1]._id);
+  EXPECT_FALSE(accounts[1]._active);
+  EXPECT_EQ(-1e-05, accounts[2]._balance);
+}
+
+TEST_F(RecordFileTest, SplitLinesTest) {
+  const std::string text{"a\nbb\nccc\ndddd\n"};
+  for (std::size_t count = 1; count < 10; ++count) {
+    const auto chunks = my::split_lines(text, count);
+    EXPECT_LE(chunks.size(), count);
+
+    std::string joined{};
+    for (auto chunk : chunks) {
+      EXPECT_EQ('\n', chunk.back());
+      joined += chunk;
+    }
+    EXPECT_EQ(text, joined);
+  }
+  EXPECT_TRUE(my::split_lines("", 4).empty());
+}
+
+TEST_F(RecordFileTest, MalformedRecordTest) {
+  EXPECT_THROW(my::parse_records<Person>("Anil\n", 1), std::runtime_error);
+  EXPECT_THROW(my::parse_records<Person>("Anil Kumar Extra\n", 1), std::runtime_error);
+  EXPECT_THROW(my::parse_records<Account>("a b x 1 1\n", 1), std::runtime_error);
+
+  // errors of other threads are propagated as well
+  EXPECT_THROW(my::parse_records<Person>("a b\nc d\ne f\ng\n", 4), std::runtime_error);
+  EXPECT_THROW(my::read_record_file<Person>(_path + ".missing"), std::runtime_error);
+}
@@ -0,0 +1,77 @@
+#include <gtest/gtest.h>
+
+#include "../include/Person.h"
+#include "../include/RecordFormatter.h"
+
+#include <cstdint>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+
+struct RecordFormatterTest : ::testing::Test {
+
+  struct Measurement {
+    auto reflect() const { return std::tie(_owner, _count, _delta, _value, _flag, _code, _small); }
+
+    Person _owner;
+    std::uint64_t _count;
+    int _delta;
+    double _value;
+    bool _flag;
+    char _code;
+    float _small;
+  };
+
+  template <typename T>
+  static std::string stream_output(const std::vector<T>& records_) {
+    std::ostringstream os{};
+    for (const auto& record : records_) {
+      os << record;
+    }
+    return os.str();
+  }
+
+  template <typename T>
+  static std::string formatter_output(const std::vector<T>& records_, std::size_t flush_threshold_) {
+    std::ostringstream os{};
+    {
+      my::record_formatter formatter{os, flush_threshold_};
+      for (const auto& record : records_) {
+        formatter.write(record);
+      }
+    }
+    return os.str();
+  }
+};
+
+TEST_F(RecordFormatterTest, PersonOutputTest) {
+  std::string out{};
+  my::record_formatter::append_record(out, Person{"Anil", "Kumar"});
+  EXPECT_EQ("Anil Kumar ", out);
+
+  const std::vector<Person> people{Person{"a", "b"}, Person{"", ""}, Person{"with space", "x"}};
+  EXPECT_EQ(stream_output(people), formatter_output(people, 4));
+  EXPECT_EQ(stream_output(people), formatter_output(people, my::record_formatter::default_flush_threshold));
+}
+
+TEST_F(RecordFormatterTest, ArithmeticOutputTest) {
+  const std::vector<Measurement> measurements{
+    {Person{"a", "b"}, 0, -1, 0.0, true, 'x', 0.5f},
+    {Person{"c", "d"}, std::numeric_limits<std::uint64_t>::max(), std::numeric_limits<int>::min(), 1234.5, false, 'y', 1e-7f},
+    {Person{"e", "f"}, 42, 7, 3.14159265358979, true, 'z', 1e20f},
+    {Person{"g", "h"}, 1, 1, 1e-7, false, ' ', -2.0f / 3},
+    {Person{"i", "j"}, 1, 1, 123456789.0, false, '0', 100000.0f},
+  };
+  EXPECT_EQ(stream_output(measurements), formatter_output(measurements, 16));
+}
+
+TEST_F(RecordFormatterTest, FlushTest) {
+  std::ostringstream os{};
+  my::record_formatter formatter{os, 1024};
+  formatter.write(Person{"Anil", "Kumar"});
+  EXPECT_TRUE(os.str().empty()); // still buffered
+
+  formatter.flush();
+  EXPECT_EQ("Anil Kumar ", os.str());
+}
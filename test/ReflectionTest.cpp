@@ -1,5 +1,10 @@
 #include "../include/Person.h"
+#include "../include/LRUCache.h"
 #include <gtest/gtest.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <vector>
 
 class ReflectionTest : public ::testing::Test
 {
@@ -44,4 +49,97 @@ TEST_F(ReflectionTest, InputOutputOpTest) {
   EXPECT_EQ(is.str(), "FirstName SecondName ");
   is >> p;
   EXPECT_EQ(p, _notP1);
-}
\ No newline at end of file
+}
+
+TEST_F(ReflectionTest, HashTest)
+{
+  const std::hash<Person> hasher{};
+  EXPECT_EQ(hasher(_p1), hasher(_sameAsP1));
+  EXPECT_NE(hasher(_p1), hasher(_notP1));
+
+  // members are hashed in order, so swapping them changes the hash
+  EXPECT_NE(hasher(Person("Anil", "Kumar")), hasher(Person("Kumar", "Anil")));
+
+  std::unordered_set<std::size_t> hashes{};
+  for (int i = 0; i < 1000; ++i) {
+    hashes.insert(hasher(Person("name", std::to_string(i))));
+  }
+  EXPECT_EQ(1000, hashes.size());
+}
+
+TEST_F(ReflectionTest, NestedHashTest)
+{
+  struct Couple {
+    auto reflect() const { return std::tie(_first, _second, _years); }
+    Person _first;
+    Person _second;
+    int _years;
+  };
+
+  const my::reflection_hash<Couple> hasher{};
+  EXPECT_EQ(hasher(Couple{_p1, _notP1, 5}), hasher(Couple{_sameAsP1, _notP1, 5}));
+  EXPECT_NE(hasher(Couple{_p1, _notP1, 5}), hasher(Couple{_p1, _notP1, 6}));
+  EXPECT_NE(hasher(Couple{_p1, _notP1, 5}), hasher(Couple{_notP1, _p1, 5}));
+}
+
+TEST_F(ReflectionTest, AsKeyTest)
+{
+  std::unordered_map<Person, int> ages{};
+  ages[_p1] = 30;
+  ages[_notP1] = 40;
+  EXPECT_EQ(30, ages.at(_sameAsP1));
+  EXPECT_EQ(2, ages.size());
+
+  LRUCache<Person, int> cache{1};
+  cache.insert(_p1, 30);
+  EXPECT_EQ(30, cache.get(_sameAsP1)->second);
+  cache.insert(_notP1, 40);
+  EXPECT_EQ(cache.end(), cache.get(_p1));
+}
+
+TEST_F(ReflectionTest, OrderingOperatorTest)
+{
+  const Person a{"Anil", "Kumar"}, b{"Anil", "Sharma"}, c{"Bob", "Adams"};
+
+  EXPECT_TRUE(a < b);
+  EXPECT_TRUE(b < c);
+  EXPECT_FALSE(b < a);
+  EXPECT_FALSE(a < _p1);
+
+  EXPECT_TRUE(a <= _p1);
+  EXPECT_TRUE(a <= b);
+  EXPECT_FALSE(c <= b);
+
+  EXPECT_TRUE(c > a);
+  EXPECT_FALSE(a > a);
+  EXPECT_TRUE(a >= _p1);
+  EXPECT_FALSE(a >= b);
+
+  EXPECT_GT(0, my::compare(a, b));
+  EXPECT_EQ(0, my::compare(a, _p1));
+  EXPECT_LT(0, my::compare(c, a));
+
+  std::vector<Person> people{c, b, a};
+  std::sort(people.begin(), people.end());
+  EXPECT_EQ((std::vector<Person>{a, b, c}), people);
+}
+
+TEST_F(ReflectionTest, CompareReflectHintTest)
+{
+  // lengths are compared before the contents, hence shorter names come first
+  struct Name {
+    auto reflect() const { return std::tie(_value, _id); }
+    auto compare_reflect() const { return std::make_tuple(_value.size(), std::cref(_value), _id); }
+    std::string _value;
+    int _id;
+  };
+
+  const Name shorter{"zz", 1}, longer{"aaa", 1}, other_id{"zz", 2};
+  EXPECT_TRUE(shorter < longer);
+  EXPECT_TRUE(shorter < other_id);
+  EXPECT_TRUE(shorter == Name({"zz", 1}));
+  EXPECT_TRUE(shorter != other_id);
+
+  // without the hint, it is lexicographic over reflect()
+  EXPECT_TRUE(Person("aaa", "") < Person("zz", ""));
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include "../include/Person.h"
+#include "../include/SoaVector.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+  // outside the fixture, as reflect() must be deduced before fixture's soa_vector member is instantiated
+  struct Employee {
+    auto reflect() const { return std::tie(_id, _salary, _person); }
+    auto mut_reflect() { return std::tie(_id, _salary, _person); }
+
+    int _id{};
+    double _salary{};
+    Person _person{};
+  };
+}
+
+struct SoaVectorTest : ::testing::Test {
+
+  void SetUp() override {
+    for (int i = 0; i < 10; ++i) {
+      _employees.push_back(Employee{i, 1000.0 * i, Person{"first" + std::to_string(i), "second"}});
+    }
+  }
+
+  my::soa_vector<Employee> _employees{};
+};
+
+TEST_F(SoaVectorTest, ColumnLayoutTest) {
+  static_assert(std::is_same_v<std::vector<int>, my::soa_vector<Employee>::column_t<0>>);
+  static_assert(std::is_same_v<std::vector<double>, my::soa_vector<Employee>::column_t<1>>);
+  static_assert(std::is_same_v<std::vector<Person>, my::soa_vector<Employee>::column_t<2>>);
+  static_assert(my::soa_vector<Person>::column_count == 2);
+
+  EXPECT_EQ(10, _employees.size());
+  const auto& ids = _employees.column<0>();
+  EXPECT_EQ(10, ids.size());
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(i, ids[i]);
+  }
+}
+
+TEST_F(SoaVectorTest, ProxyReferenceTest) {
+  auto [id, salary, person] = _employees[3];
+  EXPECT_EQ(3, id);
+  EXPECT_EQ(3000.0, salary);
+  EXPECT_EQ(Person("first3", "second"), person);
+
+  // proxies refer to the columns
+  salary = 1.5;
+  EXPECT_EQ(1.5, _employees.column<1>()[3]);
+
+  const auto employee = _employees.get(3);
+  EXPECT_EQ(3, employee._id);
+  EXPECT_EQ(1.5, employee._salary);
+  EXPECT_EQ(Person("first3", "second"), employee._person);
+}
+
+TEST_F(SoaVectorTest, IterationTest) {
+  int expected_id{0};
+  for (auto [id, salary, person] : _employees) {
+    EXPECT_EQ(expected_id++, id);
+    salary += 1;
+  }
+  EXPECT_EQ(10, expected_id);
+  EXPECT_EQ(1.0, _employees.column<1>()[0]);
+
+  const auto& const_employees = _employees;
+  EXPECT_EQ(10, std::distance(const_employees.begin(), const_employees.end()));
+}
+
+TEST_F(SoaVectorTest, ColumnScanTest) {
+  EXPECT_EQ(5, _employees.count_if<1>([](double salary) { return salary >= 5000.0; }));
+
+  const auto indices = _employees.filter<0>([](int id) { return id % 3 == 0; });
+  EXPECT_EQ((std::vector<std::size_t>{0, 3, 6, 9}), indices);
+
+  _employees.clear();
+  EXPECT_TRUE(_employees.empty());
+  EXPECT_TRUE(_employees.filter<0>([](int) { return true; }).empty());
+}
@@ -0,0 +1,107 @@
+#include <gtest/gtest.h>
+
+#include "../include/BinarySerialization.h"
+#include "../include/Person.h"
+#include "../include/StringPool.h"
+
+#include <set>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct StringPoolTest : ::testing::Test {
+  my::string_pool pool{4};
+};
+
+TEST_F(StringPoolTest, InternTest) {
+  const std::string anil{"Anil"};
+  const auto first = pool.intern(anil);
+  const auto second = pool.intern(std::string{"Anil"});
+  const auto other = pool.intern("Kumar");
+
+  EXPECT_EQ(first, second);
+  EXPECT_EQ(first.data(), second.data());
+  EXPECT_NE(anil.data(), first.data()); // a copy lives in the pool
+  EXPECT_NE(first, other);
+  EXPECT_EQ("Anil", first.view());
+  EXPECT_EQ(4, first.size());
+  EXPECT_EQ(2, pool.size());
+  EXPECT_EQ(9, pool.bytes());
+
+  // empty strings aren't stored, and are equal to default constructed handles (of any pool)
+  EXPECT_EQ(my::interned_string{}, pool.intern(""));
+  EXPECT_TRUE(pool.intern("").empty());
+  EXPECT_EQ(2, pool.size());
+
+  // handles of different pools differ, even for the same contents
+  EXPECT_NE(first, my::interned_string{"Anil"});
+  EXPECT_EQ(my::interned_string{"Anil"}, my::interned_string{anil});
+
+  // ordering is by contents
+  EXPECT_TRUE(first < other);
+  EXPECT_FALSE(other < first);
+  EXPECT_FALSE(first < second);
+
+  // and by pool among equal contents, consistently with operator==
+  const my::interned_string global{"Anil"};
+  EXPECT_NE(first < global, global < first);
+  EXPECT_TRUE(first < other && global < other);
+  EXPECT_EQ(2, (std::set<my::interned_string>{first, second, global}.size()));
+}
+
+TEST_F(StringPoolTest, ConcurrentInternTest) {
+  constexpr int thread_count{4};
+  constexpr int string_count{2000};
+  std::vector<std::vector<my::interned_string>> handles(thread_count);
+
+  std::vector<std::thread> threads{};
+  for (int t = 0; t < thread_count; ++t) {
+    threads.emplace_back([this, t, &handles] {
+      for (int i = 0; i < string_count; ++i) {
+        handles[t].push_back(pool.intern("name" + std::to_string((i * (t + 1)) % string_count)));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(string_count, pool.size());
+  for (int t = 0; t < thread_count; ++t) {
+    for (int i = 0; i < string_count; ++i) {
+      const auto& handle = handles[t][i];
+      EXPECT_EQ("name" + std::to_string((i * (t + 1)) % string_count), handle.view());
+      EXPECT_EQ(pool.intern(handle.view()), handle);
+    }
+  }
+}
+
+TEST_F(StringPoolTest, PersonTest) {
+  const std::string first{"Anil"};
+  const Person a{first, "Kumar"}, b{std::string_view{"Anil"}, std::string{"Kumar"}};
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(2 * sizeof(my::interned_string), sizeof(Person));
+  EXPECT_EQ(sizeof(void*), sizeof(my::interned_string));
+
+  // reflection based operators and serialization work with the interned members
+  std::ostringstream os{};
+  os << a;
+  EXPECT_EQ("Anil Kumar ", os.str());
+
+  std::string buffer(my::binary_size(a), '\0');
+  my::serialize(a, buffer.data(), buffer.size());
+  Person decoded{};
+  my::deserialize(decoded, buffer.data(), buffer.size());
+  EXPECT_EQ(a, decoded);
+
+  const std::set<Person> people{Person{"b", "a"}, Person{"a", "b"}, Person{"a", "a"}};
+  EXPECT_EQ(Person("a", "a"), *people.begin());
+  EXPECT_EQ(Person("b", "a"), *people.rbegin());
+
+  // same names of another pool are a different person, and ordering agrees
+  const Person pooled{pool.intern("Anil"), pool.intern("Kumar")};
+  EXPECT_NE(a, pooled);
+  EXPECT_NE(a < pooled, pooled < a);
+  EXPECT_EQ(2, (std::set<Person>{a, b, pooled}.size()));
+}
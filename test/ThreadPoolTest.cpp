@@ -0,0 +1,67 @@
+#include <gtest/gtest.h>
+
+#include "../include/ThreadPool.h"
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+struct ThreadPoolTest : ::testing::Test {
+  my::thread_pool pool{4};
+};
+
+TEST_F(ThreadPoolTest, EveryIndexOnce) {
+  EXPECT_EQ(4, pool.size());
+
+  for (std::size_t count : {0, 1, 3, 1000}) {
+    std::vector<std::atomic<int>> calls(count);
+    pool.parallel_for(count, [&calls](std::size_t i) { ++calls[i]; });
+    for (const auto& c : calls) {
+      EXPECT_EQ(1, c.load());
+    }
+  }
+}
+
+TEST_F(ThreadPoolTest, UnevenWork) {
+  // first index is way slower than the rest, the other threads take over the rest of the loop
+  std::vector<std::thread::id> ids(64);
+  pool.parallel_for(ids.size(), [&ids](std::size_t i) {
+    if (i == 0) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    ids[i] = std::this_thread::get_id();
+  });
+
+  std::size_t sameAsFirst{0};
+  for (const auto& id : ids) {
+    sameAsFirst += (id == ids[0]);
+  }
+  EXPECT_LT(sameAsFirst, ids.size());
+}
+
+TEST_F(ThreadPoolTest, SingleThread) {
+  my::thread_pool single{1};
+  EXPECT_EQ(1, single.size());
+
+  std::vector<std::size_t> order{};
+  single.parallel_for(5, [&order](std::size_t i) { order.push_back(i); });
+  EXPECT_EQ((std::vector<std::size_t>{0, 1, 2, 3, 4}), order);
+}
+
+TEST_F(ThreadPoolTest, Exception) {
+  std::atomic<int> calls{0};
+  EXPECT_THROW(pool.parallel_for(1000, [&calls](std::size_t i) {
+    ++calls;
+    if (i == 10) {
+      throw std::runtime_error{"failed"};
+    }
+  }), std::runtime_error);
+  EXPECT_LT(calls.load(), 1000);
+
+  // pool is still usable
+  std::atomic<int> sum{0};
+  pool.parallel_for(10, [&sum](std::size_t i) { sum += static_cast<int>(i); });
+  EXPECT_EQ(45, sum.load());
+}
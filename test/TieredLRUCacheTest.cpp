@@ -0,0 +1,183 @@
+#include <gtest/gtest.h>
+
+#include "../include/Person.h"
+#include "../include/TieredLRUCache.h"
+
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+struct TieredLRUCacheTest : public ::testing::Test {
+
+  static std::string spillPath() {
+    return (std::filesystem::temp_directory_path() / "TieredLRUCacheTest").string();
+  }
+
+  static std::string value(int i) {
+    return "value of " + std::to_string(i);
+  }
+
+  constexpr static std::size_t _maxSize{5};
+  constexpr static std::size_t _segmentSize{256};
+  TieredLRUCache<int, std::string> _cache{_maxSize, spillPath(), _segmentSize};
+};
+
+TEST_F(TieredLRUCacheTest, SpillTest) {
+  for (int i = 0; i < 100; ++i) {
+    _cache.insert(i, value(i));
+  }
+
+  // memory tier has the last 5 insertions, rest of them are on disk
+  EXPECT_EQ(100, _cache.size());
+  auto itr = _cache.begin();
+  for (int i = 95; i < 100; ++i, ++itr) {
+    EXPECT_EQ(i, itr->first);
+  }
+
+  const auto stats = _cache.stats();
+  EXPECT_EQ(95, stats.spills);
+  EXPECT_EQ(95, stats.diskEntries);
+  EXPECT_LT(1, stats.segments);
+  EXPECT_TRUE(std::filesystem::exists(spillPath() + ".0"));
+}
+
+TEST_F(TieredLRUCacheTest, PromotionTest) {
+  for (int i = 0; i < 100; ++i) {
+    _cache.insert(i, value(i));
+  }
+
+  for (int i = 0; i < 100; ++i) {
+    auto itr = _cache.get(i);
+    ASSERT_NE(_cache.end(), itr);
+    EXPECT_EQ(i, itr->first);
+    EXPECT_EQ(value(i), itr->second);
+    EXPECT_EQ(i, std::prev(_cache.end())->first); // promoted entries are most recently used
+  }
+  EXPECT_EQ(100, _cache.size());
+  EXPECT_EQ(_cache.end(), _cache.get(100));
+
+  const auto stats = _cache.stats();
+  EXPECT_EQ(100, stats.diskHits); // getting them in insertion order keeps evicting the next one
+  EXPECT_EQ(0, stats.memoryHits);
+  EXPECT_EQ(1, stats.misses);
+}
+
+TEST_F(TieredLRUCacheTest, InsertAndEraseTest) {
+  for (int i = 0; i < 20; ++i) {
+    _cache.insert(i, value(i));
+  }
+
+  // existing key isn't overwritten, even if it's on disk
+  EXPECT_EQ(value(0), _cache.insert(0, "other")->second);
+
+  _cache.erase(1);   // on disk
+  _cache.erase(19);  // in memory
+  EXPECT_EQ(18, _cache.size());
+  EXPECT_EQ(_cache.end(), _cache.get(1));
+  EXPECT_EQ(_cache.end(), _cache.get(19));
+  EXPECT_EQ(value(2), _cache.get(2)->second);
+}
+
+TEST_F(TieredLRUCacheTest, CompactionTest) {
+  for (int i = 0; i < 200; ++i) {
+    _cache.insert(i, value(i));
+  }
+  const auto before = _cache.stats();
+
+  // erasing most of them leaves the sealed segments with mostly garbage
+  for (int i = 0; i < 200; ++i) {
+    if (i % 10 != 0) {
+      _cache.erase(i);
+    }
+  }
+  _cache.compact();
+
+  const auto after = _cache.stats();
+  EXPECT_LT(0, after.compactions);
+  EXPECT_GT(before.segments, after.segments);
+  EXPECT_GT(before.diskBytes, after.diskBytes);
+  EXPECT_EQ(20, _cache.size());
+
+  for (int i = 0; i < 200; i += 10) {
+    ASSERT_NE(_cache.end(), _cache.get(i));
+    EXPECT_EQ(value(i), _cache.get(i)->second);
+  }
+}
+
+TEST_F(TieredLRUCacheTest, BackgroundCompactionTest) {
+  for (int i = 0; i < 200; ++i) {
+    _cache.insert(i, value(i));
+  }
+  const auto before = _cache.stats();
+
+  // promoting all of them back and forth makes plenty of garbage
+  for (int i = 0; i < 200; ++i) {
+    _cache.get(i);
+  }
+
+  for (int attempt = 0; attempt < 500 && _cache.stats().compactions == 0; ++attempt) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+  EXPECT_LT(0, _cache.stats().compactions);
+
+  // whatever is left, sealed segments are at least half live afterwards
+  _cache.compact();
+  EXPECT_GE(2 * before.segments + 1, _cache.stats().segments);
+
+  for (int i = 0; i < 200; ++i) {
+    EXPECT_EQ(value(i), _cache.get(i)->second);
+  }
+}
+
+TEST_F(TieredLRUCacheTest, ConcurrentCompactionTest) {
+  for (int i = 0; i < 200; ++i) {
+    _cache.insert(i, value(i));
+  }
+  for (int i = 0; i < 200; ++i) {
+    if (i % 10 != 0) {
+      _cache.erase(i);
+    }
+  }
+
+  // runs alongside the background thread (woken up by the erases) and alongside each other
+  std::thread other{[this] { _cache.compact(); }};
+  _cache.compact();
+  other.join();
+  _cache.compact();
+
+  EXPECT_EQ(20, _cache.stats().diskEntries);
+  for (int i = 0; i < 200; i += 10) {
+    ASSERT_NE(_cache.end(), _cache.get(i));
+    EXPECT_EQ(value(i), _cache.get(i)->second);
+  }
+}
+
+TEST_F(TieredLRUCacheTest, GarbageActiveSegmentTest) {
+  // every spilled entry is erased (insert doesn't overwrite) while its segment is still the active one,
+  // so the first segment is sealed with nothing live in it
+  for (int i = 0; !std::filesystem::exists(spillPath() + ".1"); ++i) {
+    ASSERT_LT(i, 1000);
+    _cache.insert(i, value(i));
+    if (i >= static_cast<int>(_maxSize)) {
+      _cache.erase(i - static_cast<int>(_maxSize));
+    }
+  }
+  EXPECT_EQ(0, _cache.stats().diskEntries);
+
+  // sealing it asks the background thread to compact it away
+  for (int attempt = 0; attempt < 500 && std::filesystem::exists(spillPath() + ".0"); ++attempt) {
+    std::this_thread::sleep_for(std::chrono::milliseconds{1});
+  }
+  EXPECT_FALSE(std::filesystem::exists(spillPath() + ".0"));
+  EXPECT_LT(0, _cache.stats().compactions);
+}
+
+TEST_F(TieredLRUCacheTest, ReflectableValueTest) {
+  TieredLRUCache<std::string, Person> cache{1, spillPath() + ".person"};
+  cache.insert("first", Person{"anil", "kumar"});
+  cache.insert("second", Person{"ani", "kumar"});
+  EXPECT_EQ(1, cache.stats().diskEntries);
+  EXPECT_EQ(Person("anil", "kumar"), cache.get("first")->second);
+  EXPECT_EQ(Person("ani", "kumar"), cache.get("second")->second);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include "../include/Tokenizer.h"
+
+#include <iterator>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+struct TokenizerTest : ::testing::Test {
+  using views = std::vector<std::string_view>;
+
+  const views expected{"entity1", "entity2", "entity3", "entity4", "entity5", "entity6"};
+
+  // what RegexUseTest does, including the work around for empty tokens
+  static views regex_tokens(const std::string& source_) {
+    static const std::regex sep_pattern{"[[:s:]]*[,;.:][[:s:]]*"};
+    views tokens{};
+    for (std::sregex_token_iterator itr{source_.begin(), source_.end(), sep_pattern, {-1}}, end{}; itr != end; ++itr) {
+      if (itr->length() != 0) {
+        tokens.emplace_back(&*itr->first, itr->length());
+      }
+    }
+    return tokens;
+  }
+};
+
+TEST_F(TokenizerTest, BasicTokenTest) {
+  const std::string source{"entity1, entity2; entity3: entity4. entity5, entity6"};
+  EXPECT_EQ(expected, my::tokenizer{source}.to_vector());
+}
+
+TEST_F(TokenizerTest, TokenTestForSepAtEnd) {
+  const std::string source{"entity1,    entity2; entity3: entity4. entity5, entity6 ,  "};
+  EXPECT_EQ(expected, my::tokenizer{source}.to_vector());
+}
+
+TEST_F(TokenizerTest, TokenTestForSepAtBeginning) {
+  // no work around needed, empty tokens are skipped
+  const std::string source{" ,  entity1,    entity2; entity3: entity4. entity5, entity6"};
+  EXPECT_EQ(expected, my::tokenizer{source}.to_vector());
+}
+
+TEST_F(TokenizerTest, EdgeCaseTest) {
+  EXPECT_TRUE(my::tokenizer{""}.to_vector().empty());
+  EXPECT_TRUE(my::tokenizer{std::string_view{}}.to_vector().empty());
+  EXPECT_TRUE(my::tokenizer{" ,;. : "}.to_vector().empty());
+  EXPECT_EQ(views{"single"}, my::tokenizer{"single"}.to_vector());
+
+  // whitespace inside of a token is kept
+  EXPECT_EQ((views{"a b", "c\td"}), my::tokenizer{"a b,,, c\td"}.to_vector());
+
+  // custom separators
+  EXPECT_EQ((views{"a", "b", "c"}), my::tokenizer("a|b / c", "|/").to_vector());
+  EXPECT_THROW(my::tokenizer("a", ""), std::runtime_error);
+
+  // tokens are views into the source
+  const std::string source{"first, second"};
+  const my::tokenizer tokens{source};
+  EXPECT_EQ(source.data(), tokens.begin()->data());
+
+  // tokens are kept in the iterators themselves
+  static_assert(std::is_same_v<std::iterator_traits<my::tokenizer::iterator>::iterator_category, std::input_iterator_tag>);
+}
+
+TEST_F(TokenizerTest, SameAsRegexTest) {
+  // long enough to go through the 16 byte blocks, separators at every possible offset
+  std::string source{};
+  for (int i = 0; i < 200; ++i) {
+    source += "token" + std::to_string(i) + std::string(i % 5, ' ') + ",;.:"[i % 4] + std::string(i % 3, '\t');
+    if (i % 7 == 0) {
+      source += " , ";
+    }
+  }
+
+  EXPECT_EQ(regex_tokens(source), my::tokenizer{source}.to_vector());
+
+  // more than 16 separators take the table based path
+  const std::string many_separators{",;.:!?|/\\-_+*=#@%"};
+  std::string custom{"x!y?z|w/v\\u-t_s+r*q=p#o@n%m,l;k.j:i"};
+  EXPECT_EQ(18, my::tokenizer(custom, many_separators).to_vector().size());
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+
+#include "../include/TupleUtil.h"
+
+#include <string>
+#include <tuple>
+#include <vector>
+
+struct TupleUtilTest : ::testing::Test {
+  int _first{1};
+  std::string _second{"two"};
+  double _third{3.0};
+};
+
+TEST_F(TupleUtilTest, ForEachTest) {
+  std::vector<std::string> visited{};
+  tuple_for_each(std::make_tuple(1, std::string{"two"}, 'c'), [&visited](const auto& elem_) {
+    if constexpr (std::is_same_v<std::decay_t<decltype(elem_)>, std::string>) {
+      visited.push_back(elem_);
+    }
+    else {
+      visited.push_back(std::to_string(elem_));
+    }
+  });
+  EXPECT_EQ((std::vector<std::string>{"1", "two", "99"}), visited);
+
+  // empty tuple is fine as well
+  tuple_for_each(std::tuple<>{}, [](const auto&) { FAIL(); });
+}
+
+TEST_F(TupleUtilTest, MutableForEachTest) {
+  // const tuple of references still mutates the referenced variables
+  const auto refs = std::tie(_first, _third);
+  tuple_for_each(refs, [](auto& elem_) { elem_ *= 2; });
+  EXPECT_EQ(2, _first);
+  EXPECT_EQ(6.0, _third);
+
+  // non-const tuple of values
+  auto values = std::make_tuple(1, 2.5);
+  tuple_for_each(values, [](auto& elem_) { elem_ += 1; });
+  EXPECT_EQ(std::make_tuple(2, 3.5), values);
+}
+
+TEST_F(TupleUtilTest, ForEachIndexedTest) {
+  std::vector<std::size_t> indices{};
+  tuple_for_each_indexed(std::tie(_first, _second, _third), [&indices](auto index_, const auto& elem_) {
+    // index is a compile time constant
+    using expected_t = std::tuple_element_t<decltype(index_)::value, std::tuple<int, std::string, double>>;
+    static_assert(std::is_same_v<expected_t, std::decay_t<decltype(elem_)>>);
+    indices.push_back(index_);
+  });
+  EXPECT_EQ((std::vector<std::size_t>{0, 1, 2}), indices);
+}
+
+TEST_F(TupleUtilTest, AnyAllOfShortCircuitTest) {
+  const auto values = std::make_tuple(1, 2, 3, 4);
+
+  int calls{0};
+  EXPECT_TRUE(tuple_any_of(values, [&calls](int v) { ++calls; return v == 2; }));
+  EXPECT_EQ(2, calls);
+
+  calls = 0;
+  EXPECT_FALSE(tuple_any_of(values, [&calls](int v) { ++calls; return v > 4; }));
+  EXPECT_EQ(4, calls);
+
+  calls = 0;
+  EXPECT_FALSE(tuple_all_of(values, [&calls](int v) { ++calls; return v < 3; }));
+  EXPECT_EQ(3, calls);
+
+  calls = 0;
+  EXPECT_TRUE(tuple_all_of(values, [&calls](int v) { ++calls; return v > 0; }));
+  EXPECT_EQ(4, calls);
+
+  EXPECT_FALSE(tuple_any_of(std::tuple<>{}, [](const auto&) { return true; }));
+  EXPECT_TRUE(tuple_all_of(std::tuple<>{}, [](const auto&) { return false; }));
+}
@@ -0,0 +1,164 @@
+#include <gtest/gtest.h>
+
+#include "../include/Vector.h"
+
+#include <string>
+#include <vector>
+
+struct VectorTest : ::testing::Test {
+
+  // keeps track of number of live objects, to verify that nothing is constructed
+  // until it is pushed and everything pushed is eventually destroyed
+  struct Counted {
+    explicit Counted(int value_) : value(value_) { ++alive; }
+    Counted(const Counted& other_) : value(other_.value) { ++alive; }
+    Counted(Counted&& other_) noexcept : value(other_.value) { ++alive; }
+    Counted& operator=(const Counted&) = default;
+    Counted& operator=(Counted&&) noexcept = default;
+    ~Counted() { --alive; }
+
+    int value;
+    static inline int alive{0};
+  };
+
+  void SetUp() override {
+    Counted::alive = 0;
+  }
+
+  template <typename Vector>
+  static std::vector<int> values(const Vector& vector_) {
+    std::vector<int> result{};
+    for (const auto& elem : vector_) {
+      result.push_back(elem.value);
+    }
+    return result;
+  }
+};
+
+TEST_F(VectorTest, StaticVectorFrontBackTest) {
+  constexpr auto vector = [] {
+    my::static_vector<int, 4> v{};
+    v.push_back(1);
+    v.push_back(2);
+    v.push_back(3);
+    return v;
+  }();
+
+  static_assert(vector.front() == 1);
+  static_assert(vector.back() == 3);
+  EXPECT_THROW(my::static_vector<int>{}.back(), std::runtime_error);
+}
+
+TEST_F(VectorTest, SmallVectorInlineStorageTest) {
+  {
+    my::small_vector<Counted, 4> vector{};
+    EXPECT_EQ(0, Counted::alive);
+    EXPECT_TRUE(vector.is_inline());
+    EXPECT_EQ(4, vector.capacity());
+
+    vector.emplace_back(1);
+    vector.emplace_back(2);
+    EXPECT_EQ(2, Counted::alive);
+    EXPECT_TRUE(vector.is_inline());
+
+    vector.pop_back();
+    EXPECT_EQ(1, Counted::alive);
+    EXPECT_EQ(1, vector.back().value);
+  }
+  EXPECT_EQ(0, Counted::alive);
+}
+
+TEST_F(VectorTest, SmallVectorHeapSpillTest) {
+  {
+    my::small_vector<Counted, 2> vector{};
+    for (int i = 0; i < 100; ++i) {
+      vector.emplace_back(i);
+    }
+
+    EXPECT_FALSE(vector.is_inline());
+    EXPECT_EQ(100, vector.size());
+    EXPECT_EQ(100, Counted::alive);
+    for (int i = 0; i < 100; ++i) {
+      EXPECT_EQ(i, vector[i].value);
+    }
+
+    // argument referring to an element of the vector itself while growing
+    my::small_vector<std::string, 1> strings{"self"};
+    strings.push_back(strings.front());
+    EXPECT_EQ("self", strings[1]);
+  }
+  EXPECT_EQ(0, Counted::alive);
+}
+
+TEST_F(VectorTest, SmallVectorInsertEraseTest) {
+  my::small_vector<Counted, 4> vector{};
+  vector.emplace_back(1);
+  vector.emplace_back(3);
+
+  vector.insert(vector.begin() + 1, Counted{2});
+  vector.insert(vector.begin(), Counted{0});
+  vector.insert(vector.end(), Counted{4});
+  EXPECT_EQ((std::vector<int>{0, 1, 2, 3, 4}), values(vector));
+
+  vector.erase(vector.begin());
+  EXPECT_EQ((std::vector<int>{1, 2, 3, 4}), values(vector));
+
+  vector.erase(vector.begin() + 1, vector.begin() + 3);
+  EXPECT_EQ((std::vector<int>{1, 4}), values(vector));
+  EXPECT_EQ(2, Counted::alive);
+
+  EXPECT_THROW(vector.insert(vector.end() + 1, Counted{5}), std::runtime_error);
+  EXPECT_THROW(vector[2], std::runtime_error);
+}
+
+TEST_F(VectorTest, SmallVectorMoveCopyTest) {
+  my::small_vector<std::string, 2> inline_vector{"a", "b"};
+  my::small_vector<std::string, 2> heap_vector{"a", "b", "c"};
+  EXPECT_TRUE(inline_vector.is_inline());
+  EXPECT_FALSE(heap_vector.is_inline());
+
+  // heap buffer is stolen as it is
+  const auto* heap_data = heap_vector.data();
+  auto moved_heap{std::move(heap_vector)};
+  EXPECT_EQ(heap_data, moved_heap.data());
+  EXPECT_TRUE(heap_vector.empty());
+  EXPECT_TRUE(heap_vector.is_inline());
+
+  // inline elements are moved one by one
+  auto moved_inline{std::move(inline_vector)};
+  EXPECT_TRUE(moved_inline.is_inline());
+  EXPECT_EQ("a", moved_inline[0]);
+  EXPECT_EQ("b", moved_inline[1]);
+  EXPECT_TRUE(inline_vector.empty());
+
+  auto copy = moved_heap;
+  EXPECT_NE(copy.data(), moved_heap.data());
+  EXPECT_TRUE(std::equal(copy.begin(), copy.end(), moved_heap.begin(), moved_heap.end()));
+
+  copy = moved_inline;
+  EXPECT_EQ(2, copy.size());
+  EXPECT_TRUE(copy.is_inline());
+
+  copy = std::move(moved_heap);
+  EXPECT_EQ(3, copy.size());
+  EXPECT_EQ("c", copy.back());
+}
+
+TEST_F(VectorTest, AccessPolicyTest) {
+  my::static_vector<int, 2, my::access_policy::checked> checked{};
+  EXPECT_THROW(checked[0], std::runtime_error);
+  EXPECT_THROW(checked.back(), std::runtime_error);
+
+  // unchecked access compiles down to a plain array access, hence nothing to observe
+  // apart from the fact that a valid access behaves exactly like a checked one
+  my::static_vector<int, 2, my::access_policy::unchecked> unchecked{};
+  unchecked.push_back(7);
+  unchecked[0] += 1;
+  EXPECT_EQ(8, unchecked.back());
+
+  my::small_vector<int, 2, my::access_policy::debug_checked> debug_checked{1, 2, 3};
+  EXPECT_EQ(3, debug_checked[2]);
+#ifndef NDEBUG
+  EXPECT_DEATH(debug_checked[3], "Assertion");
+#endif
+}
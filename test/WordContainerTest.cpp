@@ -1,7 +1,56 @@
 #include <gtest/gtest.h>
 
 #include "../include/WordContainer.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <memory_resource>
+#include <new>
+#include <random>
 #include <set>
+#include <string_view>
+#include <vector>
+
+namespace {
+  // counts every call to global operator new, to verify that query path doesn't allocate
+  // atomic, as the rest of the tests of the binary allocate from their background threads as well
+  std::atomic<std::size_t> allocation_count{0};
+}
+
+void* operator new(std::size_t size) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size ? size : 1)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept {
+  std::free(ptr);
+}
+
+// std::pmr::new_delete_resource and over-aligned types (e.g. blocks of the filter) go through these
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  allocation_count.fetch_add(1, std::memory_order_relaxed);
+  const auto align = static_cast<std::size_t>(alignment);
+  if (void* ptr = std::aligned_alloc(align, (size + align - 1) / align * align)) {
+    return ptr;
+  }
+  throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
 
 struct WordContainerTest : ::testing::Test {
   WordContainer wc{};
@@ -32,4 +81,269 @@ TEST_F(WordContainerTest, GetTest) {
 
   std::set<std::string> expected{"wo", "wom", "me", "men", "women"};
   EXPECT_EQ(expected, words);
-}
\ No newline at end of file
+}
+
+TEST_F(WordContainerTest, StringViewQueryTest) {
+  wc.add("wo");
+  wc.add("men");
+
+  const char buffer[] = "womenfolk";
+  const std::string_view query{buffer, 5};
+  EXPECT_TRUE(wc.contains(query.substr(2)));
+  EXPECT_FALSE(wc.contains(query));
+
+  // only first 8 chars are considered
+  std::set<std::string> words{};
+  wc.get("wonxxxxxme", std::inserter(words, words.end()));
+  std::set<std::string> expected{"wo"};
+  EXPECT_EQ(expected, words);
+}
+
+TEST_F(WordContainerTest, NoAllocationQueryTest) {
+  wc.add("wo");
+  wc.add("wom");
+  wc.add("me");
+  wc.add("men");
+  wc.add("women");
+
+  std::vector<std::string_view> words{};
+  words.reserve(8);
+  const char buffer[] = "women";
+
+  const auto before = allocation_count.load();
+  const bool found = wc.contains(buffer);
+  wc.get(buffer, std::back_inserter(words));
+  const auto after = allocation_count.load();
+
+  EXPECT_TRUE(found);
+  EXPECT_EQ(5, words.size());
+  EXPECT_EQ(before, after);
+}
+
+TEST_F(WordContainerTest, ResultCacheTest) {
+  for (auto word : {"wo", "wom", "me", "men", "man", "woman", "women"}) {
+    wc.add(word);
+  }
+
+  auto query = [this](std::string_view str_) {
+    std::vector<std::string> words{};
+    words.reserve(8);
+    wc.get(str_, std::back_inserter(words));
+    return words;
+  };
+
+  const auto expected = query("women");
+  const auto anagram = query("nemow");
+  ASSERT_NE(expected, anagram); // subsets are enumerated in the order of the chars of the query
+  ASSERT_TRUE(std::is_permutation(expected.begin(), expected.end(), anagram.begin(), anagram.end()));
+
+  wc.enableResultCache(16);
+  EXPECT_EQ(expected, query("women"));
+
+  // cached results are what the query returns, and anagrams share them, in the order of the first one
+  const auto before = allocation_count.load();
+  EXPECT_EQ(expected, query("women"));
+  EXPECT_EQ(expected, query("nemow"));
+  EXPECT_EQ(before + 2, allocation_count.load()); // just the output vectors
+
+  // adding a word invalidates them
+  wc.add("now");
+  auto withNow = query("women");
+  EXPECT_NE(expected, withNow);
+  EXPECT_NE(withNow.end(), std::find(withNow.begin(), withNow.end(), "now"));
+
+  wc.disableResultCache();
+  EXPECT_EQ(withNow, query("women"));
+}
+
+TEST_F(WordContainerTest, ResultCacheMoveTest) {
+  WordContainer moved{};
+  std::vector<std::string> expected{};
+  {
+    std::pmr::unsynchronized_pool_resource pool{};
+    WordContainer pooled{&pool};
+    for (auto word : {"wo", "wom", "me", "men", "man", "woman", "women"}) {
+      pooled.add(word);
+    }
+    pooled.enableResultCache(16);
+    pooled.get("women", std::back_inserter(expected));
+
+    // resources differ, hence the words are moved into new nodes, and the old ones go away with the pool
+    moved = std::move(pooled);
+  }
+
+  std::vector<std::string> words{};
+  moved.get("women", std::back_inserter(words));
+  EXPECT_EQ(expected, words);
+}
+
+TEST_F(WordContainerTest, ResultCacheCopyTest) {
+  for (auto word : {"wo", "wom", "me", "men", "man", "woman", "women"}) {
+    wc.add(word);
+  }
+  wc.enableResultCache(16);
+  std::vector<std::string> expected{};
+  wc.get("women", std::back_inserter(expected));
+
+  // the copy has a cache of its own, words added to it don't show up in the original
+  auto copy = wc;
+  copy.add("now");
+  std::vector<std::string> words{};
+  wc.get("women", std::back_inserter(words));
+  EXPECT_EQ(expected, words);
+  words.clear();
+  copy.get("women", std::back_inserter(words));
+  EXPECT_NE(words.end(), std::find(words.begin(), words.end(), "now"));
+}
+
+TEST_F(WordContainerTest, ManyWordsTest) {
+  // enough of them to grow the filter a few times
+  std::vector<std::string> added{};
+  std::string word{"aaaa"};
+  for (int i = 0; i < 5000; ++i) {
+    word[i % 4] = static_cast<char>('a' + (word[i % 4] - 'a' + 1 + i) % 26);
+    wc.add(word);
+    added.push_back(word);
+  }
+
+  for (const auto& str : added) {
+    EXPECT_TRUE(wc.contains(str));
+  }
+  EXPECT_FALSE(wc.contains("zzzzzzzz"));
+}
+
+TEST_F(WordContainerTest, ParallelGetTest) {
+  for (auto word : {"wo", "wom", "me", "men", "man", "woman", "women", "on", "no", "ow", "eon", "mow", "meow"}) {
+    wc.add(word);
+  }
+
+  my::thread_pool pool{4};
+  for (std::string_view query : {"", "o", "women", "wonxxxxxme", "moowen", "owomwenn"}) {
+    std::vector<std::string> expected{};
+    wc.get(query, std::back_inserter(expected));
+
+    // same words in the same order, however the subsets are split
+    for (std::size_t split = 0; split <= 9; ++split) {
+      std::vector<std::string> words{};
+      wc.get(query, std::back_inserter(words), pool, split);
+      EXPECT_EQ(expected, words) << query << " split " << split;
+    }
+  }
+}
+
+TEST_F(WordContainerTest, MemoryResourceTest) {
+  // null upstream: throws if the arena runs out, instead of silently falling back to the heap
+  std::array<std::byte, 1 << 16> buffer{};
+  std::pmr::monotonic_buffer_resource arena{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+  WordContainer arenaWc{&arena};
+
+  auto addAll = [](WordContainer& wc_) {
+    const auto before = allocation_count.load();
+    for (auto word : {"wo", "wom", "me", "men", "man", "woman", "women"}) {
+      wc_.add(word);
+    }
+    return allocation_count.load() - before;
+  };
+
+  // nodes and buckets of the map come from the arena (words fit into the small string buffer),
+  // just the filter allocates from the heap
+  EXPECT_EQ(1, addAll(arenaWc));
+  EXPECT_LT(1, addAll(wc));
+
+  std::vector<std::string> expected{};
+  wc.get("women", std::back_inserter(expected));
+  std::vector<std::string> words{};
+  arenaWc.get("women", std::back_inserter(words));
+  EXPECT_EQ(expected, words);
+  EXPECT_TRUE(arenaWc.contains("woman"));
+}
+
+TEST_F(WordContainerTest, SimilarTest) {
+  for (auto word : {"wo", "wom", "me", "men", "man", "woman", "women", "a", ""}) {
+    wc.add(word);
+  }
+
+  auto similar = [this](std::string_view str_) {
+    std::vector<std::string> words{};
+    wc.getSimilar(str_, std::back_inserter(words));
+    return words;
+  };
+  auto similarSet = [&similar](std::string_view str_) {
+    const auto words = similar(str_);
+    return std::set<std::string>(words.begin(), words.end());
+  };
+
+  EXPECT_THROW(similar("men"), std::runtime_error);
+  wc.enableSimilarIndex();
+  wc.add("omen"); // added after the index is built
+
+  EXPECT_EQ("men", similar("men").front()); // exact match first
+  EXPECT_EQ((std::set<std::string>{"men", "omen", "me", "man"}), similarSet("men"));
+  EXPECT_EQ((std::set<std::string>{"women", "omen", "woman"}), similarSet("wmoen"));
+  EXPECT_EQ((std::set<std::string>{"woman", "women"}), similarSet("womxn")); // substitutions
+  EXPECT_EQ((std::set<std::string>{"women"}), similarSet("womenx"));
+  EXPECT_EQ((std::set<std::string>{"a", ""}), similarSet("b"));
+  EXPECT_TRUE(similar("zzzzzzzzz").empty()); // one more than the longest word
+  EXPECT_TRUE(similar("zzzzzzzzzz").empty());
+
+  wc.disableSimilarIndex();
+  EXPECT_THROW(similar("men"), std::runtime_error);
+}
+
+TEST_F(WordContainerTest, SimilarRecallTest) {
+  std::mt19937 generator{11};
+  std::uniform_int_distribution<int> letter{'a', 'h'}; // few letters, so that there are lots of similar words
+  std::uniform_int_distribution<std::size_t> length{1, 8};
+  auto randomWord = [&](std::size_t size_) {
+    std::string word(size_, ' ');
+    for (auto& c : word) {
+      c = static_cast<char>(letter(generator));
+    }
+    return word;
+  };
+
+  std::vector<std::string> words{};
+  for (int i = 0; i < 500; ++i) {
+    words.push_back(randomWord(length(generator)));
+    wc.add(words.back());
+  }
+  wc.enableSimilarIndex();
+
+  // multisets are an edit apart iff each has at most one char the other doesn't
+  auto isSimilar = [](std::string_view left_, std::string_view right_) {
+    std::array<int, 256> counts{};
+    for (unsigned char c : left_) {
+      ++counts[c];
+    }
+    for (unsigned char c : right_) {
+      --counts[c];
+    }
+    int surplus{0}, deficit{0};
+    for (auto count : counts) {
+      (count > 0 ? surplus : deficit) += std::abs(count);
+    }
+    return surplus <= 1 && deficit <= 1;
+  };
+
+  for (int i = 0; i < 300; ++i) {
+    const auto query = randomWord(std::uniform_int_distribution<std::size_t>{0, 9}(generator));
+    std::vector<std::string> found{};
+    wc.getSimilar(query, std::back_inserter(found));
+
+    // no false positives, and every similar word is found, once (anagrams of an earlier word aren't added)
+    std::set<std::string> expected{}, unique(found.begin(), found.end());
+    for (const auto& word : words) {
+      if (isSimilar(query, word) && wc.contains(word)) {
+        std::vector<std::string> anagrams{};
+        wc.get(word, std::back_inserter(anagrams));
+        for (const auto& anagram : anagrams) {
+          if (anagram.size() == word.size()) {
+            expected.insert(anagram);
+          }
+        }
+      }
+    }
+    EXPECT_EQ(expected, unique) << query;
+    EXPECT_EQ(unique.size(), found.size()) << query;
+  }
+}